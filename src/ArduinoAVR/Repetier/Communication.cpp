@@ -149,6 +149,9 @@ FSTRINGVALUE(Com::tZMaxColon, "z_max:")
 FSTRINGVALUE(Com::tZ2MinMaxColon, "z2_minmax:")
 FSTRINGVALUE(Com::tJerkColon, "Jerk:")
 FSTRINGVALUE(Com::tZJerkColon, " ZJerk:")
+#if JUNCTION_DEVIATION
+FSTRINGVALUE(Com::tJunctionDeviationColon, "JunctionDeviation:")
+#endif
 FSTRINGVALUE(Com::tLinearStepsColon, " linear steps:")
 FSTRINGVALUE(Com::tQuadraticStepsColon, " quadratic steps:")
 FSTRINGVALUE(Com::tCommaSpeedEqual, ", speed=")
@@ -332,7 +335,20 @@ FSTRINGVALUE(Com::tEPRXBacklash, "X backlash [mm]")
 FSTRINGVALUE(Com::tEPRYBacklash, "Y backlash [mm]")
 FSTRINGVALUE(Com::tEPRZBacklash, "Z backlash [mm]")
 FSTRINGVALUE(Com::tEPRMaxJerk, "Max. jerk [mm/s]")
+#if JUNCTION_DEVIATION
+FSTRINGVALUE(Com::tEPRJunctionDeviation, "Junction deviation [mm]")
+#endif
 FSTRINGVALUE(Com::tEPRAccelerationFactorAtTop, "Acceleration factor at top [%,100=like bottom]")
+#if DYNAMIC_PRINTLINE_CACHE
+FSTRINGVALUE(Com::tEPRMoveCacheSize, "Move cache size [moves, active after reset]")
+#endif
+#if INPUT_SHAPING
+FSTRINGVALUE(Com::tEPRInputShaperType, "Input shaper [0=ZV,1=ZVD,2=MZV]")
+FSTRINGVALUE(Com::tEPRInputShaperFrequencyX, "Input shaper X frequency [Hz,0=off]")
+FSTRINGVALUE(Com::tEPRInputShaperDampingX, "Input shaper X damping ratio")
+FSTRINGVALUE(Com::tEPRInputShaperFrequencyY, "Input shaper Y frequency [Hz,0=off]")
+FSTRINGVALUE(Com::tEPRInputShaperDampingY, "Input shaper Y damping ratio")
+#endif
 #if NONLINEAR_SYSTEM
 FSTRINGVALUE(Com::tEPRSegmentsPerSecondPrint, "Segments/s for printing")
 FSTRINGVALUE(Com::tEPRSegmentsPerSecondTravel, "Segments/s for travel")
@@ -480,10 +496,12 @@ void Com::config(FSTRINGPARAM(text)) {
     printF(tConfig);
     printFLN(text);
 }
+#ifndef INT32_IS_INT // same as int32_t version
 void Com::config(FSTRINGPARAM(text), int value) {
     printF(tConfig);
     printFLN(text, value);
 }
+#endif
 void Com::config(FSTRINGPARAM(text), const char *msg) {
     printF(tConfig);
     printF(text);
@@ -547,10 +565,12 @@ void Com::printF(FSTRINGPARAM(text), const char *msg) {
     print(msg);
 }
 
+#ifndef INT32_IS_INT // same as int32_t version
 void Com::printF(FSTRINGPARAM(text), int value) {
     printF(text);
     print(value);
 }
+#endif
 void Com::printF(FSTRINGPARAM(text), int32_t value) {
     printF(text);
     print(value);
@@ -559,11 +579,13 @@ void Com::printF(FSTRINGPARAM(text), uint32_t value) {
     printF(text);
     printNumber(value);
 }
+#ifndef INT32_IS_INT // same as int32_t version
 void Com::printFLN(FSTRINGPARAM(text), int value) {
     printF(text);
     print(value);
     println();
 }
+#endif
 void Com::printFLN(FSTRINGPARAM(text), int32_t value) {
     printF(text);
     print(value);
@@ -22,15 +22,26 @@
 #ifndef COMMUNICATION_H
 #define COMMUNICATION_H
 
-#ifndef MAX_DATA_SOURCES
-#define MAX_DATA_SOURCES 4
+#ifndef MAX_DATA_SOURCES // serial ports, usb, sd card, flash and one free place for own sources
+#if SERIAL_USB_SOURCE
+#define MAX_DATA_SOURCES 6
+#else
+#define MAX_DATA_SOURCES 5
+#endif
+#endif
+#define SOURCE_PRIORITY_FILE 0 ///< Sources that always have the next command, like sd card prints
+#define SOURCE_PRIORITY_HOST 1 ///< Interactive sources: serial connections, usb and menu actions
+#ifndef OUTPUT_BUFFER_SIZE
+#define OUTPUT_BUFFER_SIZE 96 ///< Output collected before it is sent to the sources, at most 255
 #endif
 
 /** This class defines the general interface to handle gcode communication with the firmware. This
 allows it to connect to different data sources and handle them all inside the same data structure.
-If several readers are active, the first one sending a byte pauses all other inputs until the command
-is complete. Only then the next reader will be queried. New queries are started in round robin fashion
-so every channel gets the same chance to send commands.
+After each command the next source is selected by rotateSource. Sources that have a complete command
+in their receive buffer come first, the highest priority wins and sources with equal priority are queried
+in round robin fashion. A command that is still arriving is only started if no other source has a
+complete one, as the started source pauses all other inputs until its command is complete. So host
+queries over a serial connection are answered between the lines of a running sd card print.
 
 Available source types are:
 - serial communication port
@@ -44,16 +55,28 @@ class GCodeSource {
     static GCodeSource *writeableSources[MAX_DATA_SOURCES];
     public:
     static GCodeSource *activeSource;
-    static void registerSource(GCodeSource *newSource);
+    static bool registerSource(GCodeSource *newSource); ///< false if MAX_DATA_SOURCES are registered
     static void removeSource(GCodeSource *delSource);
     static void rotateSource(); ///< Move active to next source
+    static uint8_t outputBuffer[OUTPUT_BUFFER_SIZE];
+    static uint8_t outputLength;
+    static GCodeSource *outputTarget; ///< Source the buffered output is for, NULL for all
     static void writeToAll(uint8_t byte); ///< Write to all listening sources
+    static void flushOutput(bool wait);
     static void printAllFLN(FSTRINGPARAM(text) );
     static void printAllFLN(FSTRINGPARAM(text), int32_t v);
     uint32_t lastLineNumber;
     uint8_t wasLastCommandReceivedAsBinary; ///< Was the last successful command in binary mode?
     millis_t timeOfLastDataPacket;
     int8_t waitingForResend; ///< Waiting for line to be resend. -1 = no wait.
+    uint8_t priority; ///< SOURCE_PRIORITY_FILE or SOURCE_PRIORITY_HOST, higher is read first
+#if ACK_WINDOW
+    uint8_t ackWindow; ///< Lines the host may send without ok, 0 = one ok per line
+    uint8_t unacknowledged; ///< Received lines not acknowledged so far
+#endif
+#if FEATURE_BINARY_V3
+    int32_t binaryPosition[4]; ///< X, Y, Z and E of the last version 3 move in protocol units
+#endif
 
     GCodeSource();
     virtual ~GCodeSource() {}
@@ -61,9 +84,27 @@ class GCodeSource {
     virtual bool supportsWrite() = 0; ///< true if write is a non dummy function
     virtual bool closeOnError() = 0; // return true if the channel can not interactively correct errors.
     virtual bool dataAvailable() = 0; // would read return a new byte?
+    /** true if the next command is received completely, so reading it does not wait for
+    more data. Sources that can not tell return dataAvailable(). */
+    virtual bool commandAvailable() {
+        return dataAvailable();
+    }
     virtual int readByte() = 0;
+    /** Copies the rest of the current line including the line end at once. Returns 0 if
+    no complete line is buffered, the parser then continues byte by byte. */
+    virtual uint8_t readLine(uint8_t *buffer, uint8_t maxLength) {
+        return 0;
+    }
     virtual void close() = 0;
     virtual void writeByte(uint8_t byte) = 0;
+    virtual void writeBytes(const uint8_t *data, uint8_t length) {
+        while(length--)
+            writeByte(*data++);
+    }
+    /** Bytes that can be written without waiting, 255 if unknown. */
+    virtual int writeSpace() {
+        return 255;
+    }
 };
 
 class Com
@@ -180,6 +221,9 @@ FSTRINGVAR(tZ2MinMaxColon)
 FSTRINGVAR(tZMaxColon)
 FSTRINGVAR(tJerkColon)
 FSTRINGVAR(tZJerkColon)
+#if JUNCTION_DEVIATION
+FSTRINGVAR(tJunctionDeviationColon)
+#endif
 FSTRINGVAR(tLinearStepsColon)
 FSTRINGVAR(tQuadraticStepsColon)
 FSTRINGVAR(tCommaSpeedEqual)
@@ -348,6 +392,9 @@ FSTRINGVAR(tEPRPrinterActive)
 FSTRINGVAR(tEPRMaxInactiveTime)
 FSTRINGVAR(tEPRStopAfterInactivty)
 FSTRINGVAR(tEPRMaxJerk)
+#if JUNCTION_DEVIATION
+FSTRINGVAR(tEPRJunctionDeviation)
+#endif
 FSTRINGVAR(tEPRXHomePos)
 FSTRINGVAR(tEPRYHomePos)
 FSTRINGVAR(tEPRZHomePos)
@@ -360,6 +407,16 @@ FSTRINGVAR(tEPRZBacklash)
 FSTRINGVAR(tEPRZAcceleration)
 FSTRINGVAR(tEPRZTravelAcceleration)
 FSTRINGVAR(tEPRAccelerationFactorAtTop)
+#if DYNAMIC_PRINTLINE_CACHE
+FSTRINGVAR(tEPRMoveCacheSize)
+#endif
+#if INPUT_SHAPING
+FSTRINGVAR(tEPRInputShaperType)
+FSTRINGVAR(tEPRInputShaperFrequencyX)
+FSTRINGVAR(tEPRInputShaperDampingX)
+FSTRINGVAR(tEPRInputShaperFrequencyY)
+FSTRINGVAR(tEPRInputShaperDampingY)
+#endif
 FSTRINGVAR(tEPRZStepsPerMM)
 FSTRINGVAR(tEPRZMaxFeedrate)
 FSTRINGVAR(tEPRZHomingFeedrate)
@@ -484,7 +541,9 @@ FSTRINGVAR(tTrinamicMicrostepMode)
 
 static void cap(FSTRINGPARAM(text));
 static void config(FSTRINGPARAM(text));
+#ifndef INT32_IS_INT
 static void config(FSTRINGPARAM(text),int value);
+#endif
 static void config(FSTRINGPARAM(text),const char *msg);
 static void config(FSTRINGPARAM(text),int32_t value);
 static void config(FSTRINGPARAM(text),uint32_t value);
@@ -498,21 +557,25 @@ static void printInfoFLN(FSTRINGPARAM(text));
 static void printErrorFLN(FSTRINGPARAM(text));
 static void printFLN(FSTRINGPARAM(text));
 static void printF(FSTRINGPARAM(text));
+#ifndef INT32_IS_INT
 static void printF(FSTRINGPARAM(text),int value);
+#endif
 static void printF(FSTRINGPARAM(text),const char *msg);
 static void printF(FSTRINGPARAM(text),int32_t value);
 static void printF(FSTRINGPARAM(text),uint32_t value);
 static void printF(FSTRINGPARAM(text),float value,uint8_t digits=2);
+#ifndef INT32_IS_INT
 static void printFLN(FSTRINGPARAM(text),int value);
+#endif
 static void printFLN(FSTRINGPARAM(text),int32_t value);
 static void printFLN(FSTRINGPARAM(text),uint32_t value);
 static void printFLN(FSTRINGPARAM(text),const char *msg);
 static void printFLN(FSTRINGPARAM(text),float value,uint8_t digits=2);
 static void printArrayFLN(FSTRINGPARAM(text),float *arr,uint8_t n=4,uint8_t digits=2);
-static void printArrayFLN(FSTRINGPARAM(text),long *arr,uint8_t n=4);
+static void printArrayFLN(FSTRINGPARAM(text),int32_t *arr,uint8_t n=4);
 static void print(long value);
 static inline void print(uint32_t value) {printNumber(value);}
-static inline void print(int value) {print((int32_t)value);}
+static inline void print(int value) {print((long)value);}
 static void print(const char *text);
 static inline void print(char c) {GCodeSource::writeToAll(c);}
 static void printFloat(float number, uint8_t digits);
@@ -1182,6 +1182,30 @@ own weight, so this is nearly never needed. */
 /** Comment this to disable ramp acceleration */
 #define RAMP_ACCELERATION 1
 
+/** Use a jerk free s-curve velocity profile (10t^3-15t^4+6t^5) instead of constant
+acceleration for the ramps. The acceleration rises smoothly from 0 to the configured
+acceleration and back to 0. This reduces ringing at the start and end of ramps. The
+mean acceleration of such a ramp is only 1/1.875 of its peak, so the planner uses
+this lower value and ramps take 1.875 times longer than with constant acceleration.
+Requires RAMP_ACCELERATION. Costs some cycles in the stepper interrupt during ramps. */
+#define S_CURVE_ACCELERATION 0
+
+/** Input shaping for the x and y motor of cartesian printers. Every x/y step is split into
+2 or 3 partial steps spread over about one resonance period, so the frame does not ring.
+Frequency and damping of each axis can be changed with M593 and are stored in EEPROM.
+Types: 0 = ZV (shortest), 1 = ZVD (more robust against wrong frequency), 2 = MZV.
+Set frequency 0 to disable shaping for an axis. Homing moves are not shaped.
+INPUT_SHAPER_QUEUE_SIZE is the number of steps per axis waiting for their delayed part,
+must be a power of 2 and should be larger than max. steps per second times 1/frequency.
+Each entry needs 4 byte per axis. */
+#define INPUT_SHAPING 0
+#define INPUT_SHAPER_TYPE 0
+#define INPUT_SHAPER_FREQUENCY_X 40
+#define INPUT_SHAPER_FREQUENCY_Y 40
+#define INPUT_SHAPER_DAMPING_X 0.1
+#define INPUT_SHAPER_DAMPING_Y 0.1
+#define INPUT_SHAPER_QUEUE_SIZE 128
+
 /** If your stepper needs a longer high signal then given, you can add a delay here.
 The delay is realized as a simple loop wasting time, which is not available for other
 computations. So make it as low as possible. For the most common drivers no delay is needed, as the
@@ -1211,6 +1235,13 @@ for some printers causing an early stall.
 
 */
 #define DOUBLE_STEP_DELAY 0 // time in microseconds
+/** With step batching the additional steps of a double/quad step interrupt are not executed
+at once. Their axes are computed with the first step and each of them gets an own interrupt
+that only sets the step pins, spread evenly over the time to the next computation. That keeps
+the step timing exact at high speeds for the cost of some more, but short interrupts.
+Cartesian printers only, arcs with ARC_NATIVE and shaped moves still step together.
+*/
+#define STEP_BATCHING 0
 
 /** If the firmware is busy, it will send a busy signal to host signaling that
  everything is fine and it only takes a bit longer to finish. That way the 
@@ -1270,6 +1301,24 @@ Overridden if EEPROM activated.
 #define MAX_JERK 20.0
 #define MAX_ZJERK 0.3
 
+/** \brief Cornering with junction deviation instead of jerk.
+
+If enabled, the speed at the join of two segments is computed from the circle that stays
+JUNCTION_DEVIATION_DISTANCE mm away from the corner, using the centripetal acceleration
+v^2/r of the segment acceleration. Curves made of many short segments are detected over
+the last JUNCTION_ARC_SEGMENTS joins turning the same direction and are driven with
+the speed of the underlying arc instead of slowing down at every facet. A join counts
+as facet if the arc through the segments differs less than JUNCTION_ARC_TOLERANCE mm
+from them. Z and extruder jerk limits still apply, xy jerk only sets the minimum corner
+speed of jerk/2.
+
+Deviation is overridden if EEPROM activated. Change it with M207 J<mm>.
+*/
+#define JUNCTION_DEVIATION 0
+#define JUNCTION_DEVIATION_DISTANCE 0.02
+#define JUNCTION_ARC_SEGMENTS 4
+#define JUNCTION_ARC_TOLERANCE 0.05
+
 /** \brief Number of moves we can cache in advance.
 
 This number of moves can be cached in advance. If you want to cache more, increase this. Especially on
@@ -1277,6 +1326,28 @@ many very short moves the cache may go empty. The minimum value is 5.
 */
 #define PRINTLINE_CACHE_SIZE 16
 
+/** \brief Replan only the part of the cache that changes.
+
+Every new move makes the path planner go backwards through all moves that are not at
+their maximum speed already. With many short moves this is the complete deceleration ramp at
+the end of the cache. With INCREMENTAL_PLANNER 1 the planner stops at the first junction that
+gets faster by no more then INCREMENTAL_PLANNER_TOLERANCE (0.02 = 2%) and keeps the moves
+in front as they are. They get the remaining speed with a later move. This costs at most the
+tolerance in junction speed and saves most of the planner time on fast short moves.
+*/
+#define INCREMENTAL_PLANNER 0
+#define INCREMENTAL_PLANNER_TOLERANCE 0.02
+
+/** \brief Plan with integer speeds.
+
+The path planner needs a square root for every junction it updates. Without floating point unit
+this is the slowest part of adding a move. With FIXED_POINT_PLANNER 1 the planner keeps speeds
+as integers in 1/16 mm/s and uses the integer square root of the HAL instead. Speeds are then
+limited to 4095 mm/s. It was only tested in the host simulator so far, enable it only if you
+can check the result on your printer.
+*/
+#define FIXED_POINT_PLANNER 0
+
 /** \brief Low filled cache size.
 
 If the cache contains less then MOVE_CACHE_LOW segments, the time per segment is limited to LOW_TICKS_PER_MOVE clock cycles.
@@ -1319,6 +1390,15 @@ For more informations, read the wiki.
 Set 1 to allow, 0 disallow a quadratic advance dependency. Linear is the dominant value, so no real need
 to activate the quadratic term. Only adds lots of computations and storage usage. */
 #define ENABLE_QUADRATIC_ADVANCE 0
+/** \brief Execute linear advance with the move steps.
+
+Set 1 to add the advance steps to the extruder steps of the moves instead of executing them in
+the extruder timer interrupt. Pending advance steps use iterations without extruder step and cancel
+extruder steps when the advance shrinks, so the extruder never reverses within a move and no
+extruder interrupt is needed. The advance follows speed changes smoothed over ADVANCE_SMOOTH_TIME
+milliseconds. Linear advance only, disables ENABLE_QUADRATIC_ADVANCE. */
+#define PLANNER_ADVANCE 0
+#define ADVANCE_SMOOTH_TIME 40
 
 
 // ##########################################################################################
@@ -1341,6 +1421,12 @@ to activate the quadratic term. Only adds lots of computations and storage usage
 #define BAUDRATE 115200
 //#define BAUDRATE 250000
 
+/** Size of the serial receive buffer in bytes, a power of 2 up to 256. The receive
+interrupt stores bytes there and counts line ends, so the parser takes complete lines
+at once. At 250000 baud 128 bytes last 5ms, use 256 if the host gets resends while
+the display updates or many short moves get planned. */
+#define SERIAL_RX_BUFFER_SIZE 128
+
 /**
 Some boards like Gen7 have a power on pin, to enable the ATX power supply. If this is defined,
 the power will be turned on without the need to call M80 if initially started.
@@ -1365,6 +1451,26 @@ boards you might need to make it inverting.
 
 /** Appends the line number after every ok send, to acknowledge the received command. Uncomment for plain ok ACK if your host has problems with this */
 #define ACK_WITH_LINENUMBER 1
+/** \brief Maximum number of lines a host may send without waiting for an ok.
+
+Hosts reading WINDOW_ACK:<n> from M115 can enable the window with M110 N<line> S<lines>. Then
+the firmware no longer answers every line, but sends ok <line> P<free planner lines>
+B<free command buffers> after half the window and whenever no further data is waiting, which
+acknowledges all lines up to <line>. After a Resend:<line> the host sends everything again
+from that line. All lines in flight must fit into the receive buffer, see SERIAL_RX_BUFFER_SIZE.
+0 disables it.
+*/
+#define ACK_WINDOW 0
+/** \brief Execute some commands as soon as they are received.
+
+M105, M220, M221 and M290 do not depend on the moves before them. With 1 they are executed
+when a host connection sends them instead of waiting until all buffered commands and moves
+before them are processed, so temperature reports and speed, flow and babystep overrides react
+at once. Their output is sent before the ok of that line. This also applies to M220/M221 inside
+a file the host streams: they then take effect before moves that are already buffered. Sd card
+prints and flash scripts always execute them in order.
+*/
+#define REALTIME_COMMANDS 0
 /** Communication errors can swallow part of the ok, which tells the host software to send
 the next command. Not receiving it will cause your printer to stop. Sending this string every
 second, if our queue is empty should prevent this. Comment it, if you don't want this feature. */
@@ -1381,6 +1487,27 @@ and it is elsewise difficult to know, what your reprap is currently doing.
 */
 #define ECHO_ON_EXECUTE 1
 
+/** \brief Bytes buffering parsed G0/G1 moves ahead of the planner.
+
+Moves are taken from the command buffer and acknowledged as soon as they are parsed and
+wait in a ring until the planner has free lines. So the host can keep sending while the planner
+is full and dense files with short segments stall less. Moves are packed with only the parameters
+they have, a G1 X Y E needs 15 bytes plus 3 (AVR) or 5 (Due) for the command source and flags.
+Only the ring is packed, the command buffer (GCODE_BUFFER_SIZE) still holds complete GCodes.
+Other commands still wait until all moves before them are queued. 0 disables the ring, the
+minimum size is 128.
+*/
+#define GCODE_MOVE_RING_SIZE 0
+
+/** \brief Accept version 3 binary move batches.
+
+Hosts reporting BINARY_V3:1 in the M115 capabilities can send G0/G1 moves as batches with one
+line number and one checksum. Coordinates are sent as variable length differences to the last
+move in 1/1000mm (E 1/10000mm) and F only when it changes, so a typical G1 X Y E needs 7 bytes
+instead of 23. See "repetier communication protocol.txt" for the format.
+*/
+#define FEATURE_BINARY_V3 0
+
 /** \brief EEPROM storage mode
 
 Set the EEPROM_MODE to 0 if you always want to use the settings in this configuration file. If not,
@@ -1746,6 +1873,12 @@ Separate commands by \n */
 
 // If you want support for G2/G3 arc commands set to true, otherwise false.
 #define ARC_SUPPORT 1
+/** Execute G2/G3 as one move. The stepper interrupt follows the circle directly
+instead of splitting it into lines of MM_PER_ARC_SEGMENT, so an arc needs one move
+cache entry. Speed on the arc is limited by the x/y acceleration, v = sqrt(a * r).
+Only for cartesian printers with equal x and y resolution, arcs are still split
+with autoleveling, distortion correction, backlash or xy axis compensation. */
+#define ARC_NATIVE 0
 
 /** You can store the current position with M401 and go back to it with M402.
    This works only if feature is set to true. */
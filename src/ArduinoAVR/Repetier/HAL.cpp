@@ -223,7 +223,7 @@ int32_t HAL::CPUDivU2(unsigned int divisor) {
 }
 
 void HAL::setupTimer() {
-#if USE_ADVANCE
+#if ADVANCE_EXTRUDER_TIMER
     EXTRUDER_TCCR = 0; // need Normal not fastPWM set by arduino init
     EXTRUDER_TIMSK |= (1 << EXTRUDER_OCIE); // Activate compa interrupt on timer 0
 #endif
@@ -675,13 +675,30 @@ ISR(TIMER1_COMPA_vect) {
     // insideTimer1 = 1;
     OCR1A = 61000;
     if(PrintLine::hasLines()) {
+#if INPUT_SHAPING
+        uint32_t delay = PrintLine::bresenhamStep();
+        InputShaper::advanceTime(delay);
+        setTimer(delay);
+#else
         setTimer(PrintLine::bresenhamStep());
+#endif
     }
+#if INPUT_SHAPING
+    else if(!InputShaper::isIdle()) {
+        uint32_t delay = InputShaper::idleStep(65000);
+        InputShaper::advanceTime(delay);
+        setTimer(delay);
+    }
+#endif
 #if FEATURE_BABYSTEPPING
     else if(Printer::zBabystepsMissing) {
         Printer::zBabystep();
         setTimer(Printer::interval);
     }
+#endif
+#if PLANNER_ADVANCE
+    else if(Printer::extruderStepsNeeded || Printer::advanceStepsSet)
+        setTimer(PrintLine::advanceIdleStep());
 #endif
     else {
         if(waitRelax == 0) {
@@ -1031,7 +1048,7 @@ ISR(PWM_TIMER_VECTOR) {
     }
 #endif
 }
-#if USE_ADVANCE
+#if ADVANCE_EXTRUDER_TIMER
 
 static int8_t extruderLastDirection = 0;
 #ifndef ADVANCE_DIR_FILTER_STEPS
@@ -1100,7 +1117,7 @@ ISR(EXTRUDER_TIMER_VECTOR) {
   Modified to use only 1 queue with fixed length by Repetier
 */
 
-ring_buffer rx_buffer = { { 0 }, 0, 0};
+ring_buffer rx_buffer = { { 0 }, 0, 0, 0, 0};
 ring_buffer_tx tx_buffer = { { 0 }, 0, 0};
 
 inline void rf_store_char(unsigned char c, ring_buffer *buffer) {
@@ -1113,6 +1130,7 @@ inline void rf_store_char(unsigned char c, ring_buffer *buffer) {
     if (i != buffer->tail) {
         buffer->buffer[buffer->head] = c;
         buffer->head = i;
+        if(c == '\n' || c == '\r') buffer->linesReceived++;
     }
 }
 #if !defined(USART0_RX_vect) && defined(USART1_RX_vect)
@@ -1352,6 +1370,7 @@ void RFHardwareSerial::end() {
 #endif
     // clear a  ny received data
     _rx_buffer->head = _rx_buffer->tail;
+    _rx_buffer->linesRead = _rx_buffer->linesReceived;
 }
 
 int RFHardwareSerial::available(void) {
@@ -1375,9 +1394,32 @@ int RFHardwareSerial::read(void) {
     }
     unsigned char c = _rx_buffer->buffer[_rx_buffer->tail];
     _rx_buffer->tail = (_rx_buffer->tail + 1) & SERIAL_BUFFER_MASK;
+    if(c == '\n' || c == '\r') _rx_buffer->linesRead++;
     return c;
 }
 
+/** Copies the buffered data up to and including the next line end. Returns the
+number of bytes copied or 0 if the receive interrupt has not seen a complete line. */
+int RFHardwareSerial::readLine(uint8_t *buffer, int maxLength) {
+    if(_rx_buffer->linesReceived == _rx_buffer->linesRead)
+        return 0;
+    uint8_t head = _rx_buffer->head;
+    uint8_t tail = _rx_buffer->tail;
+    int n = 0;
+    while(n < maxLength && tail != head) {
+        uint8_t c = _rx_buffer->buffer[tail];
+        tail = (tail + 1) & SERIAL_BUFFER_MASK;
+        buffer[n++] = c;
+        if(c == '\n' || c == '\r') {
+            _rx_buffer->linesRead++;
+            break;
+        }
+        if(c == 0) break;
+    }
+    _rx_buffer->tail = tail;
+    return n;
+}
+
 void RFHardwareSerial::flush() {
     while (_tx_buffer->head != _tx_buffer->tail)
         ;
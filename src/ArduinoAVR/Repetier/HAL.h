@@ -76,7 +76,7 @@ All known Arduino boards use 64. This value is needed for the extruder timing. *
 #endif
 #include <inttypes.h>
 #include "Stream.h"
-#ifdef EXTERNALSERIAL
+#if defined(EXTERNALSERIAL) && !defined(SERIAL_RX_BUFFER_SIZE)
 #define SERIAL_RX_BUFFER_SIZE 128
 #endif
 #if defined(ARDUINO) && ARDUINO >= 100
@@ -187,8 +187,14 @@ typedef uint8_t ufast8_t;
   Modified to use only 1 queue with fixed length by Repetier
 */
 
-#define SERIAL_BUFFER_SIZE 128
-#define SERIAL_BUFFER_MASK 127
+#ifndef SERIAL_RX_BUFFER_SIZE
+#define SERIAL_RX_BUFFER_SIZE 128
+#endif
+#if SERIAL_RX_BUFFER_SIZE > 256 || (SERIAL_RX_BUFFER_SIZE & (SERIAL_RX_BUFFER_SIZE - 1)) != 0
+#error SERIAL_RX_BUFFER_SIZE must be a power of 2 and at most 256
+#endif
+#define SERIAL_BUFFER_SIZE SERIAL_RX_BUFFER_SIZE
+#define SERIAL_BUFFER_MASK (SERIAL_RX_BUFFER_SIZE - 1)
 #undef SERIAL_TX_BUFFER_SIZE
 #undef SERIAL_TX_BUFFER_MASK
 #ifdef BIG_OUTPUT_BUFFER
@@ -204,6 +210,8 @@ struct ring_buffer
     uint8_t buffer[SERIAL_BUFFER_SIZE];
     volatile uint8_t head;
     volatile uint8_t tail;
+    volatile uint8_t linesReceived; ///< Line ends stored by the receive interrupt
+    uint8_t linesRead; ///< Line ends removed with read or readLine
 };
 struct ring_buffer_tx
 {
@@ -239,6 +247,10 @@ public:
     virtual int peek(void);
     virtual int read(void);
     virtual void flush(void);
+    int readLine(uint8_t *buffer, int maxLength);
+    inline bool lineAvailable() {
+        return _rx_buffer->linesReceived != _rx_buffer->linesRead;
+    }
 #ifdef COMPAT_PRE1
     virtual void write(uint8_t);
 #else
@@ -250,6 +262,8 @@ public:
 };
 extern RFHardwareSerial RFSerial;
 #define RFSERIAL RFSerial
+#define SERIAL_LINE_BUFFER 1 // RFSERIAL.readLine and lineAvailable are available
+#define SERIAL_WRITE_SPACE 1 // RFSERIAL.outputUnused is available
 //extern ring_buffer tx_buffer;
 #define WAIT_OUT_EMPTY while(tx_buffer.head != tx_buffer.tail) {}
 #else
@@ -749,7 +763,7 @@ public:
     static void servoMicroseconds(uint8_t servo,int ms, uint16_t autoOff);
 #endif
     static void analogStart();
-#if USE_ADVANCE
+#if ADVANCE_EXTRUDER_TIMER
     static void resetExtruderDirection();
 #endif
 protected:
@@ -0,0 +1,144 @@
+/*
+    This file is part of Repetier-Firmware.
+
+    Repetier-Firmware is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Repetier-Firmware is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Repetier-Firmware.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#include "Repetier.h"
+
+#if INPUT_SHAPING
+
+#if (INPUT_SHAPER_QUEUE_SIZE & INPUT_SHAPER_QUEUE_MASK) != 0 || INPUT_SHAPER_QUEUE_SIZE < 16
+#error INPUT_SHAPER_QUEUE_SIZE must be a power of 2 and at least 16
+#endif
+
+ShapedAxis InputShaper::x, InputShaper::y;
+uint32_t InputShaper::now = 0;
+bool InputShaper::active = false;
+uint8_t InputShaper::type = INPUT_SHAPER_TYPE;
+float InputShaper::frequency[2] = {INPUT_SHAPER_FREQUENCY_X, INPUT_SHAPER_FREQUENCY_Y};
+float InputShaper::damping[2] = {INPUT_SHAPER_DAMPING_X, INPUT_SHAPER_DAMPING_Y};
+
+/** Queue is full, so the oldest step gets all its delayed impulses now. Happens only if
+the queue is too small for the step rate and delay. Shaping gets worse, but no step is lost. */
+void ShapedAxis::flushOldest() {
+    uint16_t oldest = tail[numEchos - 1];
+    bool dirPositive = queue[oldest] & 1;
+    for(ufast8_t i = 0; i < numEchos; i++)
+        if(tail[i] == oldest) {
+            residual += dirPositive ? amplitude[i + 1] : -amplitude[i + 1];
+            tail[i] = (oldest + 1) & INPUT_SHAPER_QUEUE_MASK;
+        }
+}
+
+uint32_t ShapedAxis::ticksToNextEcho(uint32_t now) {
+    uint32_t wait = 0xffffffffUL;
+    for(ufast8_t i = 0; i < numEchos; i++) {
+        if(tail[i] == head) continue;
+        int32_t due = static_cast<int32_t>((queue[tail[i]] & ~1UL) + delay[i] - now);
+        if(due <= 0) return 0;
+        if(static_cast<uint32_t>(due) < wait) wait = due;
+    }
+    return wait;
+}
+
+/** Computes impulse amplitudes and delays. Damped period and amplitudes for ZV and ZVD are
+the classic Singer/Seering shapers, MZV uses 3 impulses spread over 3/4 period. */
+void ShapedAxis::configure(uint8_t type, float frequency, float damping) {
+    shaperType = type;
+    shaperFrequency = frequency;
+    shaperDamping = damping;
+    head = 0;
+    tail[0] = tail[1] = 0;
+    residual = 0;
+    if(frequency <= 0) {
+        numEchos = 0;
+        amplitude[0] = INPUT_SHAPER_ONE;
+        return;
+    }
+    damping = constrain(damping, 0.0f, 0.9f);
+    float root = sqrt(1.0f - damping * damping);
+    float period = 1.0f / (RMath::max(frequency, 1.0f) * root);
+    float a[3], t[3];
+    t[0] = 0;
+    if(type == INPUT_SHAPER_MZV) {
+        float k = exp(-0.75f * damping * M_PI / root);
+        a[0] = 1.0f - 1.0f / sqrt(2.0f);
+        a[1] = (sqrt(2.0f) - 1.0f) * k;
+        a[2] = a[0] * k * k;
+        t[1] = 0.375f * period;
+        t[2] = 0.75f * period;
+        numEchos = 2;
+    } else {
+        float k = exp(-damping * M_PI / root);
+        a[0] = 1.0f;
+        a[1] = (type == INPUT_SHAPER_ZVD ? 2.0f * k : k);
+        a[2] = k * k;
+        t[1] = 0.5f * period;
+        t[2] = period;
+        numEchos = (type == INPUT_SHAPER_ZVD ? 2 : 1);
+    }
+    float sum = a[0];
+    for(ufast8_t i = 1; i <= numEchos; i++)
+        sum += a[i];
+    int32_t first = INPUT_SHAPER_ONE;
+    for(ufast8_t i = 1; i <= numEchos; i++) {
+        amplitude[i] = static_cast<int32_t>(a[i] / sum * INPUT_SHAPER_ONE + 0.5f);
+        first -= amplitude[i];
+        delay[i - 1] = static_cast<uint32_t>(t[i] * F_CPU);
+    }
+    amplitude[0] = first;
+}
+
+/** Called by the stepper interrupt when no move is running or a move has to wait
+until shaping is done. Returns ticks until the next call. */
+uint32_t InputShaper::idleStep(uint32_t maxWait) {
+    step();
+    Printer::insertStepperHighDelay();
+    Printer::endXYZSteps();
+    uint32_t wait = x.ticksToNextEcho(now);
+    uint32_t waitY = y.ticksToNextEcho(now);
+    if(waitY < wait) wait = waitY;
+    if((x.pendingStep() || y.pendingStep()) && wait > F_CPU / STEP_DOUBLER_LIMIT)
+        wait = F_CPU / STEP_DOUBLER_LIMIT;
+    if(wait < F_CPU / 100000)
+        wait = F_CPU / 100000;
+    if(wait > maxWait)
+        wait = maxWait;
+    return wait;
+}
+
+/** Takes over new settings. Waits until all moves and delayed steps are finished,
+as the stepper interrupt uses the derived values. */
+void InputShaper::updateDerived() {
+    if(x.isConfigured(type, frequency[X_AXIS], damping[X_AXIS]) && y.isConfigured(type, frequency[Y_AXIS], damping[Y_AXIS]))
+        return;
+    Commands::waitUntilEndOfAllMoves();
+    while(!isIdle())
+        Commands::checkForPeriodicalActions(false);
+    InterruptProtectedBlock noInts;
+    x.configure(type, frequency[X_AXIS], damping[X_AXIS]);
+    y.configure(type, frequency[Y_AXIS], damping[Y_AXIS]);
+}
+
+void InputShaper::reportStatus() {
+    Com::printF(PSTR("Input shaper:"), (int)type);
+    Com::printF(PSTR(" X"), frequency[X_AXIS], 1);
+    Com::printF(Com::tSlash, damping[X_AXIS], 3);
+    Com::printF(PSTR(" Y"), frequency[Y_AXIS], 1);
+    Com::printFLN(Com::tSlash, damping[Y_AXIS], 3);
+}
+
+#endif
@@ -0,0 +1,84 @@
+/*
+    This file is part of Repetier-Firmware.
+
+    Repetier-Firmware is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Repetier-Firmware is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Repetier-Firmware.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef _ISR_LOAD_H
+#define _ISR_LOAD_H
+
+#if ISR_LOAD_STATISTICS || defined(DOXYGEN)
+
+/** \brief Run time statistics of one interrupt routine in CPU cycles. */
+class IsrTimer {
+public:
+    uint32_t calls;        ///< Calls since last reset
+    uint32_t minCycles;    ///< Shortest call since last reset
+    uint32_t maxCycles;    ///< Longest call since last reset
+    uint32_t overruns;     ///< Calls that could not keep the requested time, stepper only
+    uint32_t windowCycles; ///< Cycles spent in the running measurement window
+    uint64_t totalCycles;  ///< Cycles of all closed windows since last reset
+    uint8_t load;          ///< Percent of cpu time in the last window
+    uint8_t peakLoad;      ///< Highest load since last reset
+
+    INLINE void add(uint32_t cycles) {
+        calls++;
+        windowCycles += cycles;
+        if(cycles < minCycles) minCycles = cycles;
+        if(cycles > maxCycles) maxCycles = cycles;
+    }
+    void reset();
+    void closeWindow(uint32_t elapsed);
+    void report(FSTRINGPARAM(name));
+};
+
+/** Adds the run time of the enclosing block, so early returns are counted as well. */
+class IsrTimerBlock {
+    IsrTimer &timer;
+    uint32_t start;
+public:
+    INLINE IsrTimerBlock(IsrTimer &t) : timer(t), start(HAL::cycleCounter()) {}
+    INLINE ~IsrTimerBlock() {
+        timer.add(HAL::cycleCounter() - start);
+    }
+};
+
+/** \brief Cpu load of the stepper, pwm and extruder interrupts.
+
+Measurement windows are closed every 500ms. With ISR_LOAD_ADAPTIVE a stepper
+load above ISR_LOAD_ADAPTIVE_MAX or a stepper overrun lowers the step doubler
+frequency and the delta segments per second, so the interrupt needs less time
+before steps get lost. Reset restores the configured values.
+*/
+class IsrLoad {
+public:
+    static IsrTimer stepper, pwm, extruder;
+    static uint32_t windowStart;  ///< HAL::cycleCounter() at start of the running window
+    static uint32_t lastOverruns; ///< Stepper overruns at start of the running window
+
+    static void update();
+    static void reset();
+    static void report();
+    static void reportJSON();
+};
+
+#define ISR_LOAD_MEASURE(timer) IsrTimerBlock isrTimerBlock(IsrLoad::timer)
+#define ISR_LOAD_OVERRUN IsrLoad::stepper.overruns++
+#else
+#define ISR_LOAD_MEASURE(timer)
+#define ISR_LOAD_OVERRUN
+#endif // ISR_LOAD_STATISTICS
+
+#endif
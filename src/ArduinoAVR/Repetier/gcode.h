@@ -38,14 +38,47 @@ public:
     virtual bool supportsWrite(); ///< true if write is a non dummy function
     virtual bool closeOnError(); // return true if the channel can not interactively correct errors.
     virtual bool dataAvailable(); // would read return a new byte?
+    virtual bool commandAvailable();
     virtual int readByte();
+#if SERIAL_LINE_BUFFER
+    virtual uint8_t readLine(uint8_t *buffer, uint8_t maxLength);
+#endif
+    virtual void writeByte(uint8_t byte);
+    virtual void writeBytes(const uint8_t *data, uint8_t length);
+    virtual int writeSpace();
+    virtual void close();
+};
+#if SERIAL_USB_SOURCE
+/** Native USB port as additional source next to the serial port. The USB interrupt
+of the Arduino core stores the received packets in its buffer. dataAvailable moves
+everything received from there into the own ring and counts line ends, so the
+parser takes complete lines at once and more data can be in flight. */
+class USBGCodeSource: public GCodeSource {
+    uint8_t ring[SERIAL_USB_BUFFER_SIZE];
+    uint16_t readPos;
+    uint16_t writePos;
+    uint16_t linesReceived; ///< Line ends moved into the ring, the ring can hold more than 255
+    uint16_t linesRead; ///< Line ends removed with readByte or readLine
+    void receive();
+public:
+    USBGCodeSource();
+    virtual bool isOpen();
+    virtual bool supportsWrite(); ///< true if write is a non dummy function
+    virtual bool closeOnError(); // return true if the channel can not interactively correct errors.
+    virtual bool dataAvailable(); // would read return a new byte?
+    virtual bool commandAvailable();
+    virtual int readByte();
+    virtual uint8_t readLine(uint8_t *buffer, uint8_t maxLength);
     virtual void writeByte(uint8_t byte);
+    virtual void writeBytes(const uint8_t *data, uint8_t length);
     virtual void close();
 };
+#endif
 //#pragma message "Sd support: " XSTR(SDSUPPORT)  
 #if SDSUPPORT
 class SDCardGCodeSource: public GCodeSource {
     public:
+    SDCardGCodeSource();
     virtual bool isOpen();
     virtual bool supportsWrite(); ///< true if write is a non dummy function
     virtual bool closeOnError(); // return true if the channel can not interactively correct errors.
@@ -83,6 +116,9 @@ extern SerialGCodeSource serial0Source;
 #if BLUETOOTH_SERIAL > 0
 extern SerialGCodeSource serial1Source;
 #endif
+#if SERIAL_USB_SOURCE
+extern USBGCodeSource usbSource;
+#endif
 #if SDSUPPORT
 extern SDCardGCodeSource sdSource;
 #endif
@@ -123,6 +159,9 @@ public:
     // True if origin did not come from serial console. That way we can send status messages to
     // a host only if he would normally not know about the mode switch.
     bool internalCommand;
+    // True for version 3 batch moves. X, Y, Z and E are absolute positions independent of
+    // G90/G91 and M82/M83, because the mode may still change by commands queued before.
+    bool absolutePosition;
     inline bool hasM()
     {
         return ((params & 2)!=0);
@@ -248,6 +287,11 @@ public:
     }
     void printCommand();
     bool parseBinary(uint8_t *buffer,bool fromSerial);
+    /** Writes the command in binary protocol layout without line number and checksum
+    and returns the number of bytes written. Only the parameters present are stored. */
+    uint8_t packBinary(uint8_t *buffer);
+    /** Reads a command in binary protocol layout, the checksum is not tested. */
+    void unpackBinary(uint8_t *buffer);
     bool parseAscii(char *line,bool fromSerial);
     void popCurrentCommand();
     void echoCommand();
@@ -258,6 +302,12 @@ public:
     static void pushCommand();
     static void executeFString(FSTRINGPARAM(cmd));
     static uint8_t computeBinarySize(char *ptr);
+    /** Parses the number after a G-code letter. Plain decimal numbers up to 9 digits are
+    converted without library calls with the same result as strtod, anything else is
+    passed to strtod. An empty argument "x " is treated as "x0". */
+    static float parseFloatValue(char *s);
+    /** Same as parseFloatValue for integer values. */
+    static long parseLongValue(char *s);
 	static void fatalError(FSTRINGPARAM(message));
 	static void reportFatalError();
 	static void resetFatalError();
@@ -270,27 +320,24 @@ public:
     friend class UIDisplay;
 	static FSTRINGPARAM(fatalErrorMsg);
     friend class GCodeSource;    
+    friend class GCodeMoveRing;
 protected:
     void debugCommandBuffer();
     void checkAndPushCommand();
+#if REALTIME_COMMANDS
+    bool isRealtimeCommand();
+#endif
     static void requestResend();
-    inline float parseFloatValue(char *s)
-    {
-        char *endPtr;
-        while(*s == 32) s++; // skip spaces
-        float f = (strtod(s, &endPtr));
-        if(s == endPtr) f=0.0; // treat empty string "x " as "x0"
-        return f;
-    }
-    inline long parseLongValue(char *s)
-    {
-        char *endPtr;
-        while(*s == 32) s++; // skip spaces
-        long l = (strtol(s, &endPtr, 10));
-        if(s == endPtr) l=0; // treat empty string argument "p " as "p0"
-        return l;
-    }
-
+    static bool checkBinaryChecksum(uint8_t *buffer, uint8_t size);
+#if ACK_WINDOW && NEW_COMMUNICATION
+    static void acknowledgeWindow();
+#endif
+#if FEATURE_BINARY_V3
+    static void startBinaryBatch();
+    static void nextBinaryMove();
+    static uint8_t batchPosition; ///< Next move record of a version 3 batch in commandReceiving
+    static uint8_t batchEnd; ///< End of the batch records, 0 if no batch is pending
+#endif
     static GCode commandsBuffered[GCODE_BUFFER_SIZE]; ///< Buffer for received commands.
     static uint8_t bufferReadIndex; ///< Read position in gcode_buffer.
     static uint8_t bufferWriteIndex; ///< Write position in gcode_buffer.
@@ -315,6 +362,36 @@ public:
 #endif    
 };
 
+#if GCODE_MOVE_RING_SIZE > 0 || defined(DOXYGEN)
+#define GCODE_MOVE_NO_PARAMS (2 | 512 | 32768) // M, T and text
+/** \brief Parsed G0/G1 moves waiting for the planner.
+
+Moves without M, T or text leave the command buffer as soon as they are parsed, so the next
+lines are read and acknowledged while the planner is full. Each move is stored in binary
+protocol layout with only the parameters it has, a G1 X Y E needs 15 bytes instead of the
+full GCode. Records never wrap around the end of the buffer, so they can be read in place.
+Moves go to the planner as long as it has free lines, any other command first waits until
+all moves before it are queued.
+
+This is the only packed command storage. The command buffer, parseBinary and the command
+handlers still use the complete GCode with its public X..O fields, flush unpacks each record
+into such a GCode before executing it.
+*/
+class GCodeMoveRing {
+    static uint8_t buffer[GCODE_MOVE_RING_SIZE];
+    static uint16_t readPos;
+    static uint16_t writePos;
+    static uint16_t endPos; ///< End of the records before writePos wrapped to 0, GCODE_MOVE_RING_SIZE if not wrapped
+    static uint16_t length;
+public:
+    static INLINE bool isEmpty() {
+        return length == 0;
+    }
+    static bool add(GCode *com);
+    static void flush(bool all);
+    static void reset();
+};
+#endif
 
 #if JSON_OUTPUT
 #include "SdFat.h"
@@ -28,10 +28,10 @@
 #define FLAG_WARMUP 1
 #define FLAG_NOMINAL 2
 #define FLAG_DECELERATING 4
-#define FLAG_ACCELERATION_ENABLED 8 // unused
+#define FLAG_ARC 8 // Native arc, x and y follow the circle instead of Bresenham
 #define FLAG_CHECK_ENDSTOPS 16
 #define FLAG_ALL_E_MOTORS 32 // For mixed extruder move all motors instead of selected motor
-#define FLAG_SKIP_DEACCELERATING 64 // unused
+#define FLAG_ARC_CLOCKWISE 64
 #define FLAG_BLOCKED 128
 
 /** Are the step parameter computed */
@@ -134,65 +134,117 @@ typedef struct {
 } NonlinearSegment;
 extern uint8_t lastMoveID;
 #endif
+#if ARC_NATIVE || defined(DOXYGEN)
+#define NATIVE_ARC_FRACTION_BITS 14
+
+/** Arc parameter passed from PrintLine::arc to the move queued for it. */
+typedef struct {
+    bool requested;                 ///< Next queueCartesianMove is the arc
+    bool clockwise;
+    float center[2];                ///< Circle center in steps
+    float angle;                    ///< Angular travel in rad, always positive
+    float maxSpeed;                 ///< Centripetal speed limit in mm/s
+    int32_t start[2];               ///< Start position relative to the rounded center in steps
+    int32_t end[2];                 ///< End position relative to the rounded center in steps
+    uint8_t shift;                  ///< Rotation per iteration is 2^-shift rad
+} NativeArc;
+#endif
 class UIDisplay;
-class PrintLine { // RAM usage: 24*4+15 = 113 Byte
+class PrintLine { // RAM usage cartesian with advance: AVR 116 Byte, ARM 132 Byte
     friend class UIDisplay;
 #if CPU_ARCH == ARCH_ARM
     static volatile bool nlFlag;
 #endif
 public:
     static ufast8_t linesPos; // Position for executing line movement
+#if DYNAMIC_PRINTLINE_CACHE
+    static PrintLine *lines;
+    static ufast8_t cacheSize;
+    static ufast8_t moveCacheLow;
+    static int32_t lowTicksPerMove;
+#else
     static PrintLine lines[];
+#endif
     static ufast8_t linesWritePos; // Position where we write the next cached line move
-    ufast8_t joinFlags;
-    volatile ufast8_t flags;
+#if JUNCTION_DEVIATION
+    static PrintLine *arcLast;          // Last segment added to the arc window
+    static float arcLength[JUNCTION_ARC_SEGMENTS]; // Facet lengths of the arc window in mm
+    static float arcTurn[JUNCTION_ARC_SEGMENTS];   // Direction changes of the arc window in rad
+    static ufast8_t arcPos, arcCount;
+    static int8_t arcTurnSign;
+#endif
+    // Step execution data. Everything the stepper interrupt reads for every
+    // step comes first, so it stays together in a few cache lines on ARM and
+    // within the 63 byte displacement of ldd/std on AVR. Flags are stored as
+    // bytes on all platforms, fast8_t would make them 4 byte each on ARM.
+    uint8_t joinFlags;
+    volatile uint8_t flags;
+private:
+    uint8_t dir;                       ///< Direction of movement. 1 = X+, 2 = Y+, 4= Z+, values can be combined.
+    int8_t primaryAxis;
+public:
     secondspeed_t secondSpeed; // for laser intensity or fan control
+    int32_t stepsRemaining;            ///< Remaining steps, until move is finished
 private:
-    fast8_t primaryAxis;
-    ufast8_t dir;                       ///< Direction of movement. 1 = X+, 2 = Y+, 4= Z+, values can be combined.
-    int32_t timeInTicks;
     int32_t delta[E_AXIS_ARRAY];                  ///< Steps we want to move.
     int32_t error[E_AXIS_ARRAY];                  ///< Error calculation for Bresenham algorithm
-    float speedX;                   ///< Speed in x direction at fullInterval in mm/s
-    float speedY;                   ///< Speed in y direction at fullInterval in mm/s
-    float speedZ;                   ///< Speed in z direction at fullInterval in mm/s
-    float speedE;                   ///< Speed in E direction at fullInterval in mm/s
-    float fullSpeed;                ///< Desired speed mm/s
-    float invFullSpeed;             ///< 1.0/fullSpeed for faster computation
-    float accelerationDistance2;    ///< Real 2.0*distance*acceleration mm²/s²
-    float maxJunctionSpeed;         ///< Max. junction speed between this and next segment
-    float startSpeed;               ///< Starting speed in mm/s
-    float endSpeed;                 ///< Exit speed in mm/s
-    float minSpeed;
-    float distance;
-#if NONLINEAR_SYSTEM || defined(DOXYGEN)
-    uint8_t numNonlinearSegments;       ///< Number of delta segments left in line. Decremented by stepper timer.
-    uint8_t moveID;                 ///< ID used to identify moves which are all part of the same line
-    int32_t numPrimaryStepPerSegment;   ///< Number of primary Bresenham axis steps in each delta segment
-    NonlinearSegment segments[DELTASEGMENTS_PER_PRINTLINE];
-#endif
-    ticks_t fullInterval;     ///< interval at full speed in ticks/step.
     uint32_t accelSteps;        ///< How much steps does it take, to reach the plateau.
     uint32_t decelSteps;        ///< How much steps does it take, to reach the end speed.
-    uint32_t accelerationPrim; ///< Acceleration along primary axis
-    uint32_t fAcceleration;    ///< accelerationPrim*262144/F_CPU
     speed_t vMax;              ///< Maximum reached speed in steps/s.
     speed_t vStart;            ///< Starting speed in steps/s.
     speed_t vEnd;              ///< End speed in steps/s
+    uint32_t fAcceleration;    ///< accelerationPrim*262144/F_CPU
+    ticks_t fullInterval;     ///< interval at full speed in ticks/step.
+#if S_CURVE_ACCELERATION
+    speed_t vPeak;             ///< Speed reached at the end of acceleration in steps/s.
+    uint32_t accelInv;         ///< 0xffffffff/accelTime, scales ramp time to 0..65535
+    uint32_t decelInv;
+    uint16_t accelTime;        ///< Duration of acceleration in 2^accelShift ticks
+    uint16_t decelTime;
+    uint8_t accelShift;
+    uint8_t decelShift;
+#endif
 #if USE_ADVANCE
+    uint16_t advanceL;         ///< Recomputed L value
 #if ENABLE_QUADRATIC_ADVANCE
     int32_t advanceRate;               ///< Advance steps at full speed
     int32_t advanceFull;               ///< Maximum advance at fullInterval [steps*65536]
     int32_t advanceStart;
     int32_t advanceEnd;
 #endif
-    uint16_t advanceL;         ///< Recomputed L value
+#endif
+    int32_t timeInTicks;
+#if NONLINEAR_SYSTEM || defined(DOXYGEN)
+    uint8_t numNonlinearSegments;       ///< Number of delta segments left in line. Decremented by stepper timer.
+    uint8_t moveID;                 ///< ID used to identify moves which are all part of the same line
+    int32_t numPrimaryStepPerSegment;   ///< Number of primary Bresenham axis steps in each delta segment
 #endif
 #ifdef DEBUG_STEPCOUNT
     int32_t totalStepsRemaining;
+#endif
+    // Planner data. Only used while the move is queued and planned, the
+    // stepper interrupt never touches it.
+    float speedX;                   ///< Speed in x direction at fullInterval in mm/s
+    float speedY;                   ///< Speed in y direction at fullInterval in mm/s
+    float speedZ;                   ///< Speed in z direction at fullInterval in mm/s
+    float speedE;                   ///< Speed in E direction at fullInterval in mm/s
+    float fullSpeed;                ///< Desired speed mm/s
+    float invFullSpeed;             ///< 1.0/fullSpeed for faster computation
+    planner_speed2_t accelerationDistance2; ///< Real 2.0*distance*acceleration mm^2/s^2
+    planner_speed_t maxJunctionSpeed; ///< Max. junction speed between this and next segment
+    planner_speed_t startSpeed;     ///< Starting speed in mm/s
+    planner_speed_t endSpeed;       ///< Exit speed in mm/s
+    planner_speed_t minSpeed;
+#if FIXED_POINT_PLANNER
+    planner_speed_t plannerFullSpeed; ///< fullSpeed in planner units
+#endif
+    float distance;
+    uint32_t accelerationPrim; ///< Acceleration along primary axis
+#if NONLINEAR_SYSTEM || defined(DOXYGEN)
+    // Delta segment table last, the stepper interrupt indexes it through a pointer anyway.
+    NonlinearSegment segments[DELTASEGMENTS_PER_PRINTLINE];
 #endif
 public:
-    int32_t stepsRemaining;            ///< Remaining steps, until move is finished
     static PrintLine *cur;
     static volatile ufast8_t linesCount; // Number of lines cached 0 = nothing to do
     inline bool areParameterUpToDate() {
@@ -246,6 +298,12 @@ public:
     inline bool isCheckEndstops() {
         return flags & FLAG_CHECK_ENDSTOPS;
     }
+    inline bool isArcMove() {
+        return flags & FLAG_ARC;
+    }
+    inline bool isArcClockwise() {
+        return flags & FLAG_ARC_CLOCKWISE;
+    }
     inline bool isNominalMove() {
         return flags & FLAG_NOMINAL;
     }
@@ -509,8 +567,20 @@ public:
         Printer::advanceStepsSet = tred;
         HAL::allowInterrupts();
         Printer::advanceExecuted = advanceTarget;
+#else
+#if PLANNER_ADVANCE
+        // Smoothed over ADVANCE_SMOOTH_TIME, the factor is interval / window rounded down to a power of 2
+        uint32_t window = ADVANCE_SMOOTH_TICKS;
+        fast8_t shift = 0;
+        while(shift < 16 && Printer::interval < window) {
+            window >>= 1;
+            shift++;
+        }
+        Printer::advanceSmoothed += (static_cast<int32_t>(HAL::mulu16xu16to32(v, advanceL)) - Printer::advanceSmoothed) >> shift;
+        int tred = Printer::advanceSmoothed >> 16;
 #else
         int tred = HAL::mulu6xu16shift16(v, advanceL);
+#endif
         HAL::forbidInterrupts();
         Printer::extruderStepsNeeded += tred - Printer::advanceStepsSet;
         if(tred > 0 && Printer::advanceStepsSet <= 0)
@@ -522,6 +592,27 @@ public:
 #endif
 #endif
     }
+#if PLANNER_ADVANCE
+    /** Merges the pending advance steps into the extruder steps of the move. An iteration without
+    extruder step gets a pending step in move direction, a pending step in the other direction
+    cancels the next extruder step. So the extruder never reverses within a move.
+    Returns true if the extruder has to step. */
+    INLINE bool advanceEStep(bool regular) {
+        bool positive = isEPositiveMove();
+        if(regular) {
+            if(positive ? Printer::extruderStepsNeeded >= 0 : Printer::extruderStepsNeeded <= 0)
+                return true;
+            Printer::extruderStepsNeeded += positive ? 1 : -1;
+            return false;
+        }
+        if(positive ? Printer::extruderStepsNeeded > 0 : Printer::extruderStepsNeeded < 0) {
+            Printer::extruderStepsNeeded -= positive ? 1 : -1;
+            return true;
+        }
+        return false;
+    }
+    static uint32_t advanceIdleStep();
+#endif
     INLINE bool moveDecelerating() {
         if(stepsRemaining <= static_cast<int32_t>(decelSteps)) {
             if (!(flags & FLAG_DECELERATING)) {
@@ -534,7 +625,44 @@ public:
     INLINE bool moveAccelerating() {
         return Printer::stepNumber <= accelSteps;
     }
+#if S_CURVE_ACCELERATION
+    /** Converts the time since ramp start into 0..65535 for the whole ramp. */
+    static INLINE uint16_t sCurveTime(uint32_t timer, uint16_t time, uint8_t shift, uint32_t inv) {
+        timer >>= shift;
+        if(timer >= time) return 65535;
+        return (timer * inv) >> 16;
+    }
+    /** Velocity fraction 10t^3-15t^4+6t^5 for ramp time t with 0..65535 for 0..1.
+    Acceleration is 0 at both ends of the ramp, so the profile has no jerk. */
+    static INLINE uint16_t sCurveFactor(uint16_t t) {
+        uint32_t t2 = (static_cast<uint32_t>(t) * t) >> 16;
+        uint32_t t3 = (t2 * t) >> 16;
+        uint32_t poly = 655360UL - 15UL * t + 6UL * t2; // 10-15t+6t^2, 1..10 in 16.16
+        return (t3 * (poly >> 4)) >> 12;
+    }
+    static INLINE speed_t sCurveScale(speed_t dv, uint16_t factor) {
+#if CPU_ARCH == ARCH_AVR
+        return (static_cast<uint32_t>(dv) * factor) >> 16;
+#else
+        return (static_cast<uint64_t>(dv) * factor) >> 16;
+#endif
+    }
+    INLINE speed_t sCurveAccelerationSpeed() {
+        return vStart + sCurveScale(vPeak - vStart, sCurveFactor(sCurveTime(Printer::timer, accelTime, accelShift, accelInv)));
+    }
+    INLINE speed_t sCurveDecelerationSpeed() {
+        if(Printer::vMaxReached <= vEnd) return vEnd;
+        return Printer::vMaxReached - sCurveScale(Printer::vMaxReached - vEnd, sCurveFactor(sCurveTime(Printer::timer, decelTime, decelShift, decelInv)));
+    }
+    static void sCurveRamp(float ticks, uint16_t &time, uint8_t &shift, uint32_t &inv);
+#endif
     INLINE void startXStep() {
+#if INPUT_SHAPING
+        if(InputShaper::active) {
+            InputShaper::x.command(isXPositiveMove(), InputShaper::now);
+            return;
+        }
+#endif
 #if !(GANTRY) || defined(FAST_COREXYZ)
         Printer::startXStep();
 #else
@@ -559,9 +687,37 @@ public:
 #endif
 #ifdef DEBUG_STEPCOUNT
         totalStepsRemaining--;
+#endif
+    }
+    /** Starts the steps of the axes set in axes (XSTEP, YSTEP, ZSTEP). */
+    INLINE void startXYZSteps(uint8_t axes) {
+#if STEP_PORT_PARALLEL
+#if INPUT_SHAPING
+        if(InputShaper::active) {
+            if(axes & XSTEP) startXStep();
+            if(axes & YSTEP) startYStep();
+            axes &= ~(XSTEP | YSTEP);
+        }
+#endif
+        Printer::startXYZSteps(axes);
+#ifdef DEBUG_STEPCOUNT
+        if(axes & XSTEP) totalStepsRemaining--;
+        if(axes & YSTEP) totalStepsRemaining--;
+        if(axes & ZSTEP) totalStepsRemaining--;
+#endif
+#else
+        if(axes & XSTEP) startXStep();
+        if(axes & YSTEP) startYStep();
+        if(axes & ZSTEP) startZStep();
 #endif
     }
     INLINE void startYStep() {
+#if INPUT_SHAPING
+        if(InputShaper::active) {
+            InputShaper::y.command(isYPositiveMove(), InputShaper::now);
+            return;
+        }
+#endif
 #if !(GANTRY) || DRIVE_SYSTEM == ZX_GANTRY || DRIVE_SYSTEM == XZ_GANTRY || defined(FAST_COREXYZ)
         Printer::startYStep();
 #else
@@ -654,6 +810,30 @@ public:
         InterruptProtectedBlock noInts;
         linesCount++;
     }
+#if DYNAMIC_PRINTLINE_CACHE
+    static void allocateCache();
+#endif
+    static INLINE ufast8_t getCacheSize() {
+#if DYNAMIC_PRINTLINE_CACHE
+        return cacheSize;
+#else
+        return PRINTLINE_CACHE_SIZE;
+#endif
+    }
+    static INLINE ufast8_t getMoveCacheLow() {
+#if DYNAMIC_PRINTLINE_CACHE
+        return moveCacheLow;
+#else
+        return MOVE_CACHE_LOW;
+#endif
+    }
+    static INLINE int32_t getLowTicksPerMove() {
+#if DYNAMIC_PRINTLINE_CACHE
+        return lowTicksPerMove;
+#else
+        return LOW_TICKS_PER_MOVE;
+#endif
+    }
     static uint8_t getLinesCount() {
         InterruptProtectedBlock noInts;
         return linesCount;
@@ -662,10 +842,41 @@ public:
         return &lines[linesWritePos];
     }
     static inline void computeMaxJunctionSpeed(PrintLine *previous, PrintLine *current);
+#if JUNCTION_DEVIATION
+    static float junctionDeviationSpeed(PrintLine *previous, PrintLine *current);
+#endif
     static int32_t bresenhamStep();
     static void waitForXFreeLines(uint8_t b = 1, bool allowMoves = false);
+    static inline planner_speed_t toPlannerSpeed(float v) {
+#if FIXED_POINT_PLANNER
+        return static_cast<planner_speed_t>(RMath::min(v * PLANNER_SPEED_SCALE + 0.5f, 65535.0f));
+#else
+        return v;
+#endif
+    }
+    static inline float fromPlannerSpeed(float v) {
+        return v * (1.0f / PLANNER_SPEED_SCALE);
+    }
+    /** Speed reached after accelerating from speed v over accelerationDistance2. */
+    static inline planner_speed_t reachableSpeed(planner_speed_t v, planner_speed2_t accelerationDistance2) {
+#if FIXED_POINT_PLANNER
+        uint32_t v2 = HAL::U16SquaredToU32(v);
+        if(accelerationDistance2 >= 0xFFFE0001UL - v2) // sqrt would overflow 16 bit
+            return 0xFFFF;
+        return HAL::integerSqrt(v2 + accelerationDistance2);
+#else
+        return sqrt(v * v + accelerationDistance2);
+#endif
+    }
+    inline planner_speed_t getPlannerFullSpeed() {
+#if FIXED_POINT_PLANNER
+        return plannerFullSpeed;
+#else
+        return fullSpeed;
+#endif
+    }
     static inline void forwardPlanner(ufast8_t p);
-    static inline void backwardPlanner(ufast8_t p, ufast8_t last);
+    static inline ufast8_t backwardPlanner(ufast8_t p, ufast8_t last);
     static void updateTrapezoids();
     static uint8_t insertWaitMovesIfNeeded(uint8_t pathOptimize, uint8_t waitExtraLines);
     static void LaserWarmUp(uint32_t wait);
@@ -679,18 +890,36 @@ public:
     static void moveRelativeDistanceInStepsReal(int32_t x, int32_t y, int32_t z, int32_t e, float feedrate, bool waitEnd, bool pathOptimize = true);
 #if ARC_SUPPORT || defined(DOXYGEN)
     static void arc(float *position, float *target, float *offset, float radius, uint8_t isclockwise);
+#endif
+#if ARC_NATIVE || defined(DOXYGEN)
+    static NativeArc nativeArc;
+    static bool queueNativeArc(float *position, float *target, float *offset, float radius, float angle, uint8_t isclockwise);
+    bool initNativeArc(float axisDistanceMM[]);
+    void finishNativeArc(float speed);
+    void setNativeArcSpeeds(int32_t *radius, float speed);
+    void startNativeArc();
+    inline void nativeArcStep();
+#endif
+#if STEP_BATCHING || defined(DOXYGEN)
+    inline uint8_t nextBatchStep();
+    static inline void executeBatchStep(uint8_t axes);
+    static int32_t replayStepBatch();
+#endif
+#if STEP_AXIS_TIMING || defined(DOXYGEN)
+    inline void scheduleAxisSteps(fast8_t loops);
+    static inline int32_t finishAxisSteps(int32_t interval, fast8_t loops);
 #endif
     static INLINE void previousPlannerIndex(ufast8_t &p) {
-        p = (p ? p - 1 : PRINTLINE_CACHE_SIZE - 1);
+        p = (p ? p - 1 : getCacheSize() - 1);
     }
     static INLINE void nextPlannerIndex(ufast8_t& p) {
-        p = (p >= PRINTLINE_CACHE_SIZE - 1 ? 0 : p + 1);
+        p = (p >= getCacheSize() - 1 ? 0 : p + 1);
     }
 #if NONLINEAR_SYSTEM || defined(DOXYGEN)
     static uint8_t queueNonlinearMove(uint8_t check_endstops, uint8_t pathOptimize, uint8_t softEndstop);
     static inline void queueEMove(int32_t e_diff, uint8_t check_endstops, uint8_t pathOptimize);
     inline uint16_t calculateNonlinearSubSegments(uint8_t softEndstop);
-    static inline void calculateDirectionAndDelta(int32_t difference[], ufast8_t *dir, int32_t delta[]);
+    static inline void calculateDirectionAndDelta(int32_t difference[], uint8_t *dir, int32_t delta[]);
     static inline uint8_t calculateDistance(float axis_diff[], uint8_t dir, float *distance);
 #if (SOFTWARE_LEVELING && DRIVE_SYSTEM == DELTA) || defined(DOXYGEN)
     static void calculatePlane(int32_t factors[], int32_t p1[], int32_t p2[], int32_t p3[]);
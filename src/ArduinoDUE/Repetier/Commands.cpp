@@ -35,6 +35,13 @@ void Commands::commandLoop() {
         GCode *code = GCode::peekCurrentCommand();
         //UI_SLOW; // do longer timed user interface action
         UI_MEDIUM; // do check encoder
+#if GCODE_MOVE_RING_SIZE > 0
+        if(code && GCodeMoveRing::add(code)) {
+            code->popCurrentCommand();
+            code = NULL;
+        }
+        GCodeMoveRing::flush(code != NULL); // other commands wait for all moves before them
+#endif
         if(code) {
 #if SDSUPPORT
             if(sd.savetosd) {
@@ -60,6 +67,9 @@ void Commands::commandLoop() {
 
 void Commands::checkForPeriodicalActions(bool allowNewMoves) {
     Printer::handleInterruptEvent();
+#if NEW_COMMUNICATION
+    GCodeSource::flushOutput(false); // send output waiting for a free transmit buffer
+#endif
     EVENT_PERIODICAL;
 #if defined(DOOR_PIN) && DOOR_PIN > -1
     if(Printer::updateDoorOpen()) {
@@ -76,6 +86,9 @@ void Commands::checkForPeriodicalActions(bool allowNewMoves) {
         if(manageMonitor)
             writeMonitor();
         counter500ms = 5;
+#if ISR_LOAD_STATISTICS
+        IsrLoad::update();
+#endif
         EVENT_TIMER_500MS;
     }
     // If called from queueDelta etc. it is an error to start a new move since it
@@ -107,6 +120,9 @@ void Commands::waitUntilEndOfAllBuffers() {
     GCode *code = NULL;
 #ifdef DEBUG_PRINT
     debugWaitLoop = 9;
+#endif
+#if GCODE_MOVE_RING_SIZE > 0
+    GCodeMoveRing::flush(true);
 #endif
     while(PrintLine::hasLines() || (code != NULL)) {
         //GCode::readFromSerial();
@@ -246,7 +262,7 @@ void Commands::setFanSpeed(int speed, bool immediately) {
     Printer::fanSpeed = speed;
     if(PrintLine::linesCount == 0 || immediately) {
         if(Printer::mode == PRINTER_MODE_FFF) {
-            for(fast8_t i = 0; i < PRINTLINE_CACHE_SIZE; i++)
+            for(ufast8_t i = 0; i < PrintLine::getCacheSize(); i++)
                 PrintLine::lines[i].secondSpeed = speed;         // fill all printline buffers with new fan speed value
         }
         Printer::setFanSpeedDirectly(speed);
@@ -1053,7 +1069,7 @@ void Commands::processGCode(GCode *com) {
             int lp = (int)PrintLine::linesPos;
             int wp = (int)PrintLine::linesWritePos;
             int n = (wp - lp);
-            if(n < 0) n += PRINTLINE_CACHE_SIZE;
+            if(n < 0) n += PrintLine::getCacheSize();
             noInts.unprotect();
             if(n != lc)
                 Com::printFLN(PSTR("Buffer corrupted"));
@@ -2008,6 +2024,17 @@ void Commands::processMCode(GCode *com) {
 #endif
         Com::cap(PSTR("PAUSESTOP:1"));
         Com::cap(PSTR("PREHEAT:1"));
+#if ACK_WINDOW
+        Com::printF(Com::tCap);
+        Com::printFLN(PSTR("WINDOW_ACK:"), (int)ACK_WINDOW);
+#else
+        Com::cap(PSTR("WINDOW_ACK:0"));
+#endif
+#if FEATURE_BINARY_V3
+        Com::cap(PSTR("BINARY_V3:1"));
+#else
+        Com::cap(PSTR("BINARY_V3:0"));
+#endif
         reportPrinterUsage();
         Printer::reportPrinterMode();
         break;
@@ -2178,9 +2205,14 @@ void Commands::processMCode(GCode *com) {
         Com::writeToAll = false;
         EEPROM::update(com);
         break;
-    case 207: // M207 X<XY jerk> Z<Z Jerk>
+    case 207: // M207 X<XY jerk> Z<Z Jerk> J<junction deviation>
         if(com->hasX())
             Printer::maxJerk = com->X;
+#if JUNCTION_DEVIATION
+        if(com->hasJ())
+            Printer::junctionDeviation = RMath::max(0.0f, com->J);
+        Com::printFLN(Com::tJunctionDeviationColon, Printer::junctionDeviation, 3);
+#endif
         if(com->hasE()) {
             Extruder::current->maxStartFeedrate = com->E;
             Extruder::selectExtruderById(Extruder::current->id);
@@ -2539,7 +2571,7 @@ void Commands::processMCode(GCode *com) {
         int lp = (int)PrintLine::linesPos;
         int wp = (int)PrintLine::linesWritePos;
         int n = (wp - lp);
-        if(n < 0) n += PRINTLINE_CACHE_SIZE;
+        if(n < 0) n += PrintLine::getCacheSize();
         noInts.unprotect();
         if(n != lc)
             Com::printFLN(PSTR("Buffer corrupted"));
@@ -2652,6 +2684,29 @@ void Commands::processMCode(GCode *com) {
         }
 #endif
         break;
+#if INPUT_SHAPING
+    case 593: // M593 X Y F<frequency> D<damping> S<type> - Configure input shaping, no X/Y = both
+        if(com->hasS())
+            InputShaper::type = constrain(static_cast<int>(com->S), INPUT_SHAPER_ZV, INPUT_SHAPER_MZV);
+        for(fast8_t axis = X_AXIS; axis <= Y_AXIS; axis++) {
+            if(com->hasX() != com->hasY() && com->hasX() != (axis == X_AXIS))
+                continue;
+            if(com->hasF())
+                InputShaper::frequency[axis] = RMath::max(com->F, 0.0f);
+            if(com->hasD())
+                InputShaper::damping[axis] = constrain(com->D, 0.0f, 0.9f);
+        }
+        InputShaper::updateDerived();
+        InputShaper::reportStatus();
+        break;
+#endif
+#if ISR_LOAD_STATISTICS
+    case 409: // M409 S<1> - Report interrupt run times, S1 resets the statistics
+        IsrLoad::report();
+        if(com->hasS() && com->S == 1)
+            IsrLoad::reset();
+        break;
+#endif
     case 907: { // M907 Set digital trimpot/DAC motor current using axis codes.
 #if STEPPER_CURRENT_CONTROL != CURRENT_CONTROL_MANUAL
         // If "S" is specified, use that as initial default value, then update each axis w/ specific values as found later.
@@ -2903,6 +2958,9 @@ void Commands::executeGCode(GCode *com) {
 }
 
 void Commands::emergencyStop() {
+#if GCODE_MOVE_RING_SIZE > 0
+    GCodeMoveRing::reset();
+#endif
 #if defined(KILL_METHOD) && KILL_METHOD == 1
     HAL::resetHardware();
 #else
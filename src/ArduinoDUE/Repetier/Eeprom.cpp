@@ -83,6 +83,9 @@ void EEPROM::restoreEEPROMSettingsFromConfiguration()
     Printer::homingFeedrate[Y_AXIS] = HOMING_FEEDRATE_Y;
     Printer::homingFeedrate[Z_AXIS] = HOMING_FEEDRATE_Z;
     Printer::maxJerk = MAX_JERK;
+#if JUNCTION_DEVIATION
+    Printer::junctionDeviation = JUNCTION_DEVIATION_DISTANCE;
+#endif
 #if DRIVE_SYSTEM != DELTA
     Printer::maxZJerk = MAX_ZJERK;
 #endif
@@ -121,6 +124,13 @@ void EEPROM::restoreEEPROMSettingsFromConfiguration()
     Printer::backlashX = X_BACKLASH;
     Printer::backlashY = Y_BACKLASH;
     Printer::backlashZ = Z_BACKLASH;
+#endif
+#if INPUT_SHAPING
+    InputShaper::type = INPUT_SHAPER_TYPE;
+    InputShaper::frequency[X_AXIS] = INPUT_SHAPER_FREQUENCY_X;
+    InputShaper::frequency[Y_AXIS] = INPUT_SHAPER_FREQUENCY_Y;
+    InputShaper::damping[X_AXIS] = INPUT_SHAPER_DAMPING_X;
+    InputShaper::damping[Y_AXIS] = INPUT_SHAPER_DAMPING_Y;
 #endif
     Extruder *e;
 #if NUM_EXTRUDER>0
@@ -306,6 +316,9 @@ void EEPROM::restoreEEPROMSettingsFromConfiguration()
 #endif
     initalizeUncached();
     Printer::updateDerivedParameter();
+#if INPUT_SHAPING
+    InputShaper::updateDerived();
+#endif
 #if MIXING_EXTRUDER
     Extruder::selectExtruderById(Extruder::activeMixingExtruder);
 #else
@@ -341,6 +354,9 @@ void EEPROM::storeDataIntoEEPROM(uint8_t corrupted)
     HAL::eprSetFloat(EPR_Y_HOMING_FEEDRATE,Printer::homingFeedrate[Y_AXIS]);
     HAL::eprSetFloat(EPR_Z_HOMING_FEEDRATE,Printer::homingFeedrate[Z_AXIS]);
     HAL::eprSetFloat(EPR_MAX_JERK,Printer::maxJerk);
+#if JUNCTION_DEVIATION
+    HAL::eprSetFloat(EPR_JUNCTION_DEVIATION,Printer::junctionDeviation);
+#endif
 #if DRIVE_SYSTEM != DELTA
     HAL::eprSetFloat(EPR_MAX_ZJERK,Printer::maxZJerk);
 #endif
@@ -392,6 +408,13 @@ void EEPROM::storeDataIntoEEPROM(uint8_t corrupted)
     HAL::eprSetFloat(EPR_BACKLASH_Y,0);
     HAL::eprSetFloat(EPR_BACKLASH_Z,0);
 #endif
+#if INPUT_SHAPING
+    HAL::eprSetByte(EPR_INPUT_SHAPER_TYPE,InputShaper::type);
+    HAL::eprSetFloat(EPR_INPUT_SHAPER_FREQUENCY_X,InputShaper::frequency[X_AXIS]);
+    HAL::eprSetFloat(EPR_INPUT_SHAPER_FREQUENCY_Y,InputShaper::frequency[Y_AXIS]);
+    HAL::eprSetFloat(EPR_INPUT_SHAPER_DAMPING_X,InputShaper::damping[X_AXIS]);
+    HAL::eprSetFloat(EPR_INPUT_SHAPER_DAMPING_Y,InputShaper::damping[Y_AXIS]);
+#endif
 #if FEATURE_AUTOLEVEL
     HAL::eprSetByte(EPR_AUTOLEVEL_ACTIVE,Printer::isAutolevelActive());
     for(uint8_t i = 0; i < 9; i++)
@@ -478,6 +501,9 @@ void EEPROM::initalizeUncached()
     HAL::eprSetFloat(EPR_AXISCOMP_TANXZ,AXISCOMP_TANXZ);
     HAL::eprSetFloat(EPR_Z_PROBE_BED_DISTANCE,Z_PROBE_BED_DISTANCE);
     Printer::zBedOffset = HAL::eprGetFloat(EPR_Z_PROBE_Z_OFFSET);
+#if DYNAMIC_PRINTLINE_CACHE
+    HAL::eprSetInt16(EPR_MOVE_CACHE_SIZE,PRINTLINE_CACHE_SIZE);
+#endif
 	#if NONLINEAR_SYSTEM
     HAL::eprSetInt16(EPR_DELTA_SEGMENTS_PER_SECOND_PRINT,DELTA_SEGMENTS_PER_SECOND_PRINT);
     HAL::eprSetInt16(EPR_DELTA_SEGMENTS_PER_SECOND_MOVE,DELTA_SEGMENTS_PER_SECOND_MOVE);
@@ -543,6 +569,9 @@ void EEPROM::readDataFromEEPROM(bool includeExtruder)
     Printer::homingFeedrate[Y_AXIS] = HAL::eprGetFloat(EPR_Y_HOMING_FEEDRATE);
     Printer::homingFeedrate[Z_AXIS] = HAL::eprGetFloat(EPR_Z_HOMING_FEEDRATE);
     Printer::maxJerk = HAL::eprGetFloat(EPR_MAX_JERK);
+#if JUNCTION_DEVIATION
+    Printer::junctionDeviation = HAL::eprGetFloat(EPR_JUNCTION_DEVIATION);
+#endif
 #if DRIVE_SYSTEM != DELTA
     Printer::maxZJerk = HAL::eprGetFloat(EPR_MAX_ZJERK);
 #endif
@@ -578,6 +607,13 @@ void EEPROM::readDataFromEEPROM(bool includeExtruder)
     Printer::backlashY = HAL::eprGetFloat(EPR_BACKLASH_Y);
     Printer::backlashZ = HAL::eprGetFloat(EPR_BACKLASH_Z);
 #endif
+#if INPUT_SHAPING
+    InputShaper::type = HAL::eprGetByte(EPR_INPUT_SHAPER_TYPE);
+    InputShaper::frequency[X_AXIS] = HAL::eprGetFloat(EPR_INPUT_SHAPER_FREQUENCY_X);
+    InputShaper::frequency[Y_AXIS] = HAL::eprGetFloat(EPR_INPUT_SHAPER_FREQUENCY_Y);
+    InputShaper::damping[X_AXIS] = HAL::eprGetFloat(EPR_INPUT_SHAPER_DAMPING_X);
+    InputShaper::damping[Y_AXIS] = HAL::eprGetFloat(EPR_INPUT_SHAPER_DAMPING_Y);
+#endif
 #if FEATURE_AUTOLEVEL
     if(version > 2)
     {
@@ -775,6 +811,25 @@ void EEPROM::readDataFromEEPROM(bool includeExtruder)
             Printer::axisX2StepsPerMM = X2AXIS_STEPS_PER_MM;
         }
 #endif        
+#if DYNAMIC_PRINTLINE_CACHE
+        if(version < 19) {
+            HAL::eprSetInt16(EPR_MOVE_CACHE_SIZE,PRINTLINE_CACHE_SIZE);
+        }
+#endif
+#if INPUT_SHAPING
+        if(version < 20) {
+            InputShaper::type = INPUT_SHAPER_TYPE;
+            InputShaper::frequency[X_AXIS] = INPUT_SHAPER_FREQUENCY_X;
+            InputShaper::frequency[Y_AXIS] = INPUT_SHAPER_FREQUENCY_Y;
+            InputShaper::damping[X_AXIS] = INPUT_SHAPER_DAMPING_X;
+            InputShaper::damping[Y_AXIS] = INPUT_SHAPER_DAMPING_Y;
+        }
+#endif
+#if JUNCTION_DEVIATION
+        if(version < 21) {
+            Printer::junctionDeviation = JUNCTION_DEVIATION_DISTANCE;
+        }
+#endif
         /*        if (version<8) {
         #if DRIVE_SYSTEM==DELTA
                   // Prior to version 8, the Cartesian max was stored in the zmax
@@ -798,6 +853,9 @@ void EEPROM::readDataFromEEPROM(bool includeExtruder)
     Com::selectLanguage(HAL::eprGetByte(EPR_SELECTED_LANGUAGE));
 #endif
     Printer::updateDerivedParameter();
+#if INPUT_SHAPING
+    InputShaper::updateDerived();
+#endif
     Extruder::initHeatedBed();
 #endif
 }
@@ -887,6 +945,9 @@ void EEPROM::writeSettings()
     writeLong(EPR_PRINTING_TIME, Com::tEPRPrinterActive);
     writeLong(EPR_MAX_INACTIVE_TIME, Com::tEPRMaxInactiveTime);
     writeLong(EPR_STEPPER_INACTIVE_TIME, Com::tEPRStopAfterInactivty);
+#if DYNAMIC_PRINTLINE_CACHE
+    writeInt(EPR_MOVE_CACHE_SIZE, Com::tEPRMoveCacheSize);
+#endif
 //#define EPR_ACCELERATION_TYPE 1
 #if DRIVE_SYSTEM != DELTA
     writeFloat(EPR_XAXIS_STEPS_PER_MM, Com::tEPRXStepsPerMM, 4);
@@ -907,6 +968,9 @@ writeFloat(EPR_X2AXIS_STEPS_PER_MM, Com::tEPRX2StepsPerMM, 4);
 #endif
     writeFloat(EPR_Z_HOMING_FEEDRATE, Com::tEPRZHomingFeedrate);
     writeFloat(EPR_MAX_JERK, Com::tEPRMaxJerk);
+#if JUNCTION_DEVIATION
+    writeFloat(EPR_JUNCTION_DEVIATION, Com::tEPRJunctionDeviation, 3);
+#endif
 #if DRIVE_SYSTEM != DELTA
     writeFloat(EPR_MAX_ZJERK, Com::tEPRMaxZJerk);
 #endif
@@ -921,6 +985,13 @@ writeFloat(EPR_X2AXIS_STEPS_PER_MM, Com::tEPRX2StepsPerMM, 4);
     writeFloat(EPR_BACKLASH_Y, Com::tEPRYBacklash);
     writeFloat(EPR_BACKLASH_Z, Com::tEPRZBacklash);
 #endif
+#if INPUT_SHAPING
+    writeByte(EPR_INPUT_SHAPER_TYPE, Com::tEPRInputShaperType);
+    writeFloat(EPR_INPUT_SHAPER_FREQUENCY_X, Com::tEPRInputShaperFrequencyX);
+    writeFloat(EPR_INPUT_SHAPER_DAMPING_X, Com::tEPRInputShaperDampingX, 3);
+    writeFloat(EPR_INPUT_SHAPER_FREQUENCY_Y, Com::tEPRInputShaperFrequencyY);
+    writeFloat(EPR_INPUT_SHAPER_DAMPING_Y, Com::tEPRInputShaperDampingY, 3);
+#endif
 #if NONLINEAR_SYSTEM
     writeInt(EPR_DELTA_SEGMENTS_PER_SECOND_MOVE, Com::tEPRSegmentsPerSecondTravel);
     writeInt(EPR_DELTA_SEGMENTS_PER_SECOND_PRINT, Com::tEPRSegmentsPerSecondPrint);
@@ -20,7 +20,7 @@
 #define _EEPROM_H
 
 // Id to distinguish version changes
-#define EEPROM_PROTOCOL_VERSION 18
+#define EEPROM_PROTOCOL_VERSION 21
 
 /** Where to start with our data block in memory. Can be moved if you
 have problems with other modules using the eeprom */
@@ -129,6 +129,13 @@ have problems with other modules using the eeprom */
 #define EPR_BENDING_CORRECTION_C              1044
 #define EPR_BED_PREHEAT_TEMP                  1048
 #define EPR_X2AXIS_STEPS_PER_MM               1052
+#define EPR_MOVE_CACHE_SIZE                   1056
+#define EPR_INPUT_SHAPER_TYPE                 1060
+#define EPR_INPUT_SHAPER_FREQUENCY_X          1064
+#define EPR_INPUT_SHAPER_FREQUENCY_Y          1068
+#define EPR_INPUT_SHAPER_DAMPING_X            1072
+#define EPR_INPUT_SHAPER_DAMPING_Y            1076
+#define EPR_JUNCTION_DEVIATION                1080
 #if EEPROM_MODE != 0
 #define EEPROM_FLOAT(x) HAL::eprGetFloat(EPR_##x)
 #define EEPROM_INT32(x) HAL::eprGetInt32(EPR_##x)
@@ -562,6 +569,13 @@ static inline void setTowerZFloor(float newZ) {
         return HAL::eprGetFloat(EPR_ACCELERATION_FACTOR_TOP);
 #else
         return ACCELERATION_FACTOR_TOP;
+#endif
+    }
+    static inline int16_t moveCacheSize() {
+#if EEPROM_MODE != 0
+        return HAL::eprGetInt16(EPR_MOVE_CACHE_SIZE);
+#else
+        return PRINTLINE_CACHE_SIZE;
 #endif
     }
 
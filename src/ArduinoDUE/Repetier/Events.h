@@ -98,6 +98,12 @@ Each of the following events describe the parameter and when it is called.
 // override function signature: bool parser(uint8_t c1,uint8_t c2)
 #define EVENT_CUSTOM_TEXT_PARSER(c1,c2) false
 
+// Planner profiling. START and END enclose every update of the path planner (PrintLine::updateTrapezoids).
+#define EVENT_PLANNER_UPDATE_START {}
+#define EVENT_PLANNER_UPDATE_END {}
+// Gets called in the stepper interrupt if the next move is still blocked by the path planner.
+#define EVENT_STEPPER_STARVED {}
+
 // User interface actions
 // These get only executed if there was no hot, so they are ideal to add new actions
 
@@ -771,7 +771,7 @@ void Extruder::selectExtruderById(uint8_t extruderId) {
     Printer::maxAccelerationMMPerSquareSecond[E_AXIS] = Printer::maxTravelAccelerationMMPerSquareSecond[E_AXIS] = next->maxAcceleration;
     Printer::maxTravelAccelerationStepsPerSquareSecond[E_AXIS] =
         Printer::maxPrintAccelerationStepsPerSquareSecond[E_AXIS] = Printer::maxAccelerationMMPerSquareSecond[E_AXIS] * Printer::axisStepsPerMM[E_AXIS];
-#if USE_ADVANCE
+#if ADVANCE_EXTRUDER_TIMER
     Printer::maxExtruderSpeed = (ufast8_t)floor(HAL::maxExtruderTimerFrequency() / (Extruder::current->maxFeedrate * next->stepsPerMM));
 #if CPU_ARCH == ARCH_ARM
     if(Printer::maxExtruderSpeed > 40) Printer::maxExtruderSpeed = 40;
@@ -780,7 +780,7 @@ void Extruder::selectExtruderById(uint8_t extruderId) {
 #endif
     float fmax = ((float)HAL::maxExtruderTimerFrequency() / ((float)Printer::maxExtruderSpeed * Printer::axisStepsPerMM[E_AXIS])); // Limit feedrate to interrupt speed
     if(fmax < Printer::maxFeedrate[E_AXIS]) Printer::maxFeedrate[E_AXIS] = fmax;
-#endif // USE_ADVANCE
+#endif // ADVANCE_EXTRUDER_TIMER
     Extruder::current->tempControl.updateTempControlVars();
 #if DUAL_X_AXIS
     // Unpark new current extruder
@@ -839,9 +839,9 @@ void Extruder::selectExtruderById(uint8_t extruderId) {
 #endif
     Printer::feedrate = oldfeedrate;
     Printer::updateCurrentPosition(true);
-#if USE_ADVANCE
+#if ADVANCE_EXTRUDER_TIMER
     HAL::resetExtruderDirection();
-#endif // USE_ADVANCE
+#endif // ADVANCE_EXTRUDER_TIMER
 
 #if NUM_EXTRUDER > 1 && MIXING_EXTRUDER == 0
     if(executeSelect) {// Run only when changing
@@ -67,11 +67,17 @@ void HAL::setupTimer() {
     uint32_t     tc_count, tc_clock;
 
     pmc_set_writeprotect(false);
+#if ISR_LOAD_STATISTICS
+    // Enable cycle counter for interrupt run time measurement
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
 
     // set 3 bits for interrupt group priority, 1 bits for sub-priority
     //NVIC_SetPriorityGrouping(4);
 
-#if USE_ADVANCE
+#if ADVANCE_EXTRUDER_TIMER
     // Timer for extruder control
     pmc_enable_periph_clk(EXTRUDER_TIMER_IRQ);  // enable power to timer
     //NVIC_SetPriority((IRQn_Type)EXTRUDER_TIMER_IRQ, NVIC_EncodePriority(4, 4, 1));
@@ -820,6 +826,7 @@ TcChannel *stepperChannel = (TIMER1_TIMER->TC_CHANNEL + TIMER1_TIMER_CHANNEL);
 /** \brief Timer interrupt routine to drive the stepper motors.
 */
 void TIMER1_COMPA_VECTOR () {
+    ISR_LOAD_MEASURE(stepper);
     // apparently have to read status register
     stepperChannel->TC_SR;
     stepperChannel->TC_RC = 1000000;
@@ -827,11 +834,21 @@ void TIMER1_COMPA_VECTOR () {
     if (PrintLine::hasLines()) {
         delay = PrintLine::bresenhamStep();
     }
+#if INPUT_SHAPING
+    else if (!InputShaper::isIdle()) {
+        delay = InputShaper::idleStep(10000);
+    }
+#endif
 #if FEATURE_BABYSTEPPING
     else if (Printer::zBabystepsMissing != 0) {
         Printer::zBabystep();
         delay = Printer::interval;
     }
+#endif
+#if PLANNER_ADVANCE
+    else if (Printer::extruderStepsNeeded != 0 || Printer::advanceStepsSet != 0) {
+        delay = PrintLine::advanceIdleStep();
+    }
 #endif
     else {
         if (waitRelax == 0) {
@@ -852,6 +869,9 @@ void TIMER1_COMPA_VECTOR () {
 
         delay = 10000;
     }
+#if INPUT_SHAPING
+    InputShaper::advanceTime(delay);
+#endif
     // convert old AVR timer delay value for SAM timers
     uint32_t timer_count = (delay * TIMER1_PRESCALE);
     //if (timer_count < 210) // max. 200 khz timer frequency
@@ -859,6 +879,7 @@ void TIMER1_COMPA_VECTOR () {
     InterruptProtectedBlock noInt; // prevent interruption or we might get 102s delay
     if ( stepperChannel->TC_CV + STEPPERTIMER_EXIT_TICKS > timer_count) {
         stepperChannel->TC_RC = stepperChannel->TC_CV + STEPPERTIMER_EXIT_TICKS; // should end after exiting timer interrupt
+        ISR_LOAD_OVERRUN;
         //stepperChannel->TC_CCR = TC_CCR_CLKEN | TC_CCR_SWTRG ;
     } else {
         stepperChannel->TC_RC = timer_count;
@@ -927,6 +948,7 @@ This timer is called 3906 times per second. It is used to update
 pwm values for heater and some other frequent jobs.
 */
 void PWM_TIMER_VECTOR () {
+    ISR_LOAD_MEASURE(pwm);
     //InterruptProtectedBlock noInt;
     // apparently have to read status register
     TC_GetStatus(PWM_TIMER, PWM_TIMER_CHANNEL);
@@ -1200,7 +1222,7 @@ interrupt, one step is executed. This will keep the extruder
 moving, until the total wanted movement is achieved. This will
 be done with the maximum allowable speed for the extruder.
 */
-#if USE_ADVANCE
+#if ADVANCE_EXTRUDER_TIMER
 TcChannel *extruderChannel = (EXTRUDER_TIMER->TC_CHANNEL + EXTRUDER_TIMER_CHANNEL);
 #define SLOW_EXTRUDER_TICKS  (F_CPU_TRUE / 32 / 1000) // 250us on direction change
 #define NORMAL_EXTRUDER_TICKS  (F_CPU_TRUE / 32 / EXTRUDER_CLOCK_FREQ) // 500us on direction change
@@ -1215,6 +1237,7 @@ void HAL::resetExtruderDirection() {
 // EXTRUDER_TIMER IRQ handler
 void EXTRUDER_TIMER_VECTOR () {
     InterruptProtectedBlock noInt;
+    ISR_LOAD_MEASURE(extruder);
     // apparently have to read status register
     //TC_GetStatus(EXTRUDER_TIMER, EXTRUDER_TIMER_CHANNEL);
     extruderChannel->TC_SR; // faster replacement for above line!
@@ -1261,6 +1284,97 @@ void BEEPER_TIMER_VECTOR () {
     toggle = !toggle;
 }
 
+#if SERIAL_RX_DMA
+#if (SERIAL_RX_BUFFER_SIZE & (SERIAL_RX_BUFFER_SIZE - 1)) != 0
+#error SERIAL_RX_BUFFER_SIZE must be a power of 2 with SERIAL_RX_DMA
+#endif
+#define SERIAL_RX_MASK (SERIAL_RX_BUFFER_SIZE - 1)
+
+void RFPDCSerial::begin(unsigned long baud) {
+    Serial.begin(baud);
+    UART->UART_PTCR = UART_PTCR_RXTDIS;
+    // The PDC takes every byte from UART_RHR, the Arduino interrupt only handles sending and errors.
+    UART->UART_IDR = UART_IDR_RXRDY;
+    readPos = scanPos = 0;
+    linesReceived = linesRead = 0;
+    UART->UART_RPR = reinterpret_cast<uint32_t>(buffer);
+    UART->UART_RCR = SERIAL_RX_BUFFER_SIZE;
+    UART->UART_RNPR = reinterpret_cast<uint32_t>(buffer);
+    UART->UART_RNCR = SERIAL_RX_BUFFER_SIZE;
+    UART->UART_PTCR = UART_PTCR_RXTEN;
+}
+void RFPDCSerial::end() {
+    UART->UART_PTCR = UART_PTCR_RXTDIS;
+    Serial.end();
+}
+/** Returns the ring position the PDC writes next and counts the line ends received
+since the last call. When the PDC reaches the ring end it continues with the next
+pointer, which is set to the ring start again here. If the main loop does not read for
+a complete ring, the oldest data gets overwritten and the checksum requests a resend. */
+uint32_t RFPDCSerial::receivedPos() {
+    if(UART->UART_RNCR == 0) {
+        UART->UART_RNPR = reinterpret_cast<uint32_t>(buffer);
+        UART->UART_RNCR = SERIAL_RX_BUFFER_SIZE;
+    }
+    uint32_t head = (UART->UART_RPR - reinterpret_cast<uint32_t>(buffer)) & SERIAL_RX_MASK;
+    while(scanPos != head) {
+        uint8_t c = buffer[scanPos];
+        if(c == '\n' || c == '\r') linesReceived++;
+        scanPos = (scanPos + 1) & SERIAL_RX_MASK;
+    }
+    return head;
+}
+int RFPDCSerial::available(void) {
+    return (receivedPos() - readPos) & SERIAL_RX_MASK;
+}
+int RFPDCSerial::peek(void) {
+    if(receivedPos() == readPos)
+        return -1;
+    return buffer[readPos];
+}
+int RFPDCSerial::read(void) {
+    if(receivedPos() == readPos)
+        return -1;
+    uint8_t c = buffer[readPos];
+    readPos = (readPos + 1) & SERIAL_RX_MASK;
+    if(c == '\n' || c == '\r') linesRead++;
+    return c;
+}
+bool RFPDCSerial::lineAvailable() {
+    receivedPos();
+    return linesReceived != linesRead;
+}
+/** Copies the received data up to and including the next line end. Returns the
+number of bytes copied or 0 if no complete line was received. */
+int RFPDCSerial::readLine(uint8_t *line, int maxLength) {
+    uint32_t head = receivedPos();
+    if(linesReceived == linesRead)
+        return 0;
+    int n = 0;
+    while(n < maxLength && readPos != head) {
+        uint8_t c = buffer[readPos];
+        readPos = (readPos + 1) & SERIAL_RX_MASK;
+        line[n++] = c;
+        if(c == '\n' || c == '\r') {
+            linesRead++;
+            break;
+        }
+        if(c == 0) break;
+    }
+    return n;
+}
+void RFPDCSerial::flush(void) {
+    Serial.flush();
+}
+size_t RFPDCSerial::write(uint8_t c) {
+    return Serial.write(c);
+}
+size_t RFPDCSerial::write(const uint8_t *data, size_t size) {
+    return Serial.write(data, size);
+}
+RFPDCSerial PDCSerial;
+#endif
+
 #if defined(BLUETOOTH_SERIAL) && BLUETOOTH_SERIAL > 0
 RFDoubleSerial::RFDoubleSerial() {
 }
@@ -34,6 +34,9 @@
 #ifndef SERIAL_RX_BUFFER_SIZE
 #define SERIAL_RX_BUFFER_SIZE 128
 #endif
+#ifndef SERIAL_RX_DMA
+#define SERIAL_RX_DMA 0
+#endif
 
 #ifndef HAL_H
 #define HAL_H
@@ -174,6 +177,9 @@ typedef char prog_char;
 #define	WRITE_VAR(pin, v) do{if(v) {g_APinDescription[pin].pPort->PIO_SODR = g_APinDescription[pin].ulPin;} else {g_APinDescription[pin].pPort->PIO_CODR = g_APinDescription[pin].ulPin; }}while(0)
 #define		_WRITE(port, v)			do { if (v) {DIO ##  port ## _PORT -> PIO_SODR = DIO ## port ## _PIN; } else {DIO ##  port ## _PORT->PIO_CODR = DIO ## port ## _PIN; }; } while (0)
 #define WRITE(pin,v) _WRITE(pin,v)
+/** Bit of pin if it is on PIO port, else 0. Lets several pins of one port change with one write. */
+#define _PIN_ON_PORT(pin, port) (DIO ## pin ## _PORT == port ? DIO ## pin ## _PIN : 0)
+#define PIN_ON_PORT(pin, port) _PIN_ON_PORT(pin, port)
 
 #define	SET_INPUT(pin) ::pinMode(pin,INPUT); 
 // pmc_enable_periph_clk(g_APinDescription[pin].ulPeripheralId); 
@@ -274,6 +280,40 @@ typedef unsigned int flag8_t;
 typedef int fast8_t;
 typedef unsigned int ufast8_t;
 
+#if SERIAL_RX_DMA
+#ifdef RFSERIAL
+#error SERIAL_RX_DMA works only with the programming port
+#endif
+/** Programming port with receive by the peripheral DMA controller (PDC). The PDC
+writes into a ring of SERIAL_RX_BUFFER_SIZE bytes without any interrupt, so bytes
+are not lost while the main loop is busy. Line ends are counted when new bytes
+are seen, so complete lines can be taken at once. Sending uses the Arduino driver. */
+class RFPDCSerial : public Stream
+{
+    uint8_t buffer[SERIAL_RX_BUFFER_SIZE];
+    uint32_t readPos; ///< Next byte to read
+    uint32_t scanPos; ///< Bytes before are checked for line ends
+    uint16_t linesReceived; ///< Line ends between scanPos and the start, the ring can hold more than 255
+    uint16_t linesRead; ///< Line ends removed with read or readLine
+    uint32_t receivedPos();
+  public:
+    void begin(unsigned long baud);
+    void end();
+    virtual int available(void);
+    virtual int peek(void);
+    virtual int read(void);
+    virtual void flush(void);
+    virtual size_t write(uint8_t c);
+    virtual size_t write(const uint8_t *data, size_t size);
+    using Print::write;
+    int readLine(uint8_t *line, int maxLength);
+    bool lineAvailable();
+};
+extern RFPDCSerial PDCSerial;
+#define RFSERIAL PDCSerial
+#define SERIAL_LINE_BUFFER 1 // RFSERIAL.readLine and lineAvailable are available
+#endif
+
 #ifndef RFSERIAL
 #define RFSERIAL Serial   // Programming port of the due
 //#define RFSERIAL SerialUSB  // Native USB Port of the due
@@ -369,6 +409,9 @@ class HAL
     }
 
     static uint32_t integer64Sqrt(uint64_t a);
+    static inline uint16_t integerSqrt(uint32_t a) {
+        return integer64Sqrt(a);
+    }
     // return val'val
     static inline unsigned long U16SquaredToU32(unsigned int val)
     {
@@ -655,6 +698,12 @@ class HAL
     {
       return millis();
     }
+#define HAL_CYCLE_COUNTER 1
+    /** Cpu clock cycles from the DWT cycle counter, wraps after 51 seconds. */
+    static inline uint32_t cycleCounter()
+    {
+      return DWT->CYCCNT;
+    }
     static inline char readFlashByte(PGM_P ptr)
     {
       return pgm_read_byte(ptr);
@@ -868,7 +917,7 @@ class HAL
 #endif
 
     static void analogStart(void);
-#if USE_ADVANCE
+#if ADVANCE_EXTRUDER_TIMER
     static void resetExtruderDirection();
 #endif
     static volatile uint8_t insideTimer1;
@@ -0,0 +1,162 @@
+/*
+    This file is part of Repetier-Firmware.
+
+    Repetier-Firmware is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Repetier-Firmware is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Repetier-Firmware.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef _INPUT_SHAPER_H
+#define _INPUT_SHAPER_H
+
+#if INPUT_SHAPING || defined(DOXYGEN)
+
+#define INPUT_SHAPER_ZV 0
+#define INPUT_SHAPER_ZVD 1
+#define INPUT_SHAPER_MZV 2
+#define INPUT_SHAPER_MAX_ECHOS 2
+#define INPUT_SHAPER_QUEUE_MASK (INPUT_SHAPER_QUEUE_SIZE - 1)
+#define INPUT_SHAPER_ONE 65536L // amplitude of a full step
+
+/** \brief Step queue of one shaped axis.
+
+Every step the Bresenham algorithm creates for the axis is added with the
+amplitude of the first impulse and stored with its time. Each further impulse
+of the shaper reads the queue with its own delay and adds its amplitude when
+the delay has passed. The motor follows the sum of all impulses, rounded to
+full steps. The amplitudes sum up to one step, so no step gets lost.
+*/
+class ShapedAxis {
+public:
+    uint32_t queue[INPUT_SHAPER_QUEUE_SIZE]; ///< Step times, bit 0 is set for positive steps
+    uint16_t head;                          ///< Next free queue entry
+    uint16_t tail[INPUT_SHAPER_MAX_ECHOS];  ///< Next entry each delayed impulse reads
+    ufast8_t numEchos;                      ///< Number of delayed impulses, 0 = not shaped
+    bool positive;                          ///< Current direction of the motor
+    int32_t residual;                       ///< Commanded minus executed position, INPUT_SHAPER_ONE = 1 step
+    int32_t amplitude[INPUT_SHAPER_MAX_ECHOS + 1]; ///< Impulse amplitudes, sum is INPUT_SHAPER_ONE
+    uint32_t delay[INPUT_SHAPER_MAX_ECHOS]; ///< Impulse delays in ticks
+    uint8_t shaperType;                     ///< Settings the derived values are computed for
+    float shaperFrequency, shaperDamping;
+
+    INLINE void command(bool dirPositive, uint32_t now) {
+        if(numEchos) {
+            if(((head + 1) & INPUT_SHAPER_QUEUE_MASK) == tail[numEchos - 1])
+                flushOldest();
+            queue[head] = (now & ~1UL) | (dirPositive ? 1 : 0);
+            head = (head + 1) & INPUT_SHAPER_QUEUE_MASK;
+        }
+        residual += dirPositive ? amplitude[0] : -amplitude[0];
+    }
+    INLINE void processEchos(uint32_t now) {
+        for(ufast8_t i = 0; i < numEchos; i++) {
+            while(tail[i] != head) {
+                uint32_t entry = queue[tail[i]];
+                if(static_cast<int32_t>(now - (entry & ~1UL)) < static_cast<int32_t>(delay[i]))
+                    break;
+                residual += (entry & 1) ? amplitude[i + 1] : -amplitude[i + 1];
+                tail[i] = (tail[i] + 1) & INPUT_SHAPER_QUEUE_MASK;
+            }
+        }
+    }
+    /** Returns 1 if a positive step is needed, -1 for a negative step and 0 otherwise. */
+    INLINE fast8_t pendingStep() {
+        if(residual >= INPUT_SHAPER_ONE / 2) return 1;
+        if(residual <= -INPUT_SHAPER_ONE / 2) return -1;
+        return 0;
+    }
+    INLINE bool isIdle() {
+        return (numEchos == 0 || tail[numEchos - 1] == head) && pendingStep() == 0;
+    }
+    /** amplitude[0] is 0 until the first configure call. */
+    bool isConfigured(uint8_t type, float frequency, float damping) {
+        return amplitude[0] != 0 && type == shaperType && frequency == shaperFrequency && damping == shaperDamping;
+    }
+    uint32_t ticksToNextEcho(uint32_t now);
+    void flushOldest();
+    void configure(uint8_t type, float frequency, float damping);
+};
+
+/** \brief Input shaping for the x and y motor.
+
+Convolves the step stream of x and y with a ZV, ZVD or MZV impulse train to
+cancel the ringing of the axis at its resonance frequency. Homing moves
+are never shaped, they wait until all delayed steps are done.
+Only for cartesian printers where a motor moves exactly one axis.
+*/
+class InputShaper {
+public:
+    static ShapedAxis x, y;
+    static uint32_t now;           ///< Stepper interrupt time in ticks
+    static bool active;            ///< Current move is shaped
+    static uint8_t type;           ///< INPUT_SHAPER_ZV, INPUT_SHAPER_ZVD or INPUT_SHAPER_MZV
+    static float frequency[2];     ///< Resonance frequency of x and y in Hz, 0 = off
+    static float damping[2];       ///< Damping ratio of x and y
+
+    static INLINE bool isIdle() {
+        return x.isIdle() && y.isIdle();
+    }
+    static INLINE void advanceTime(uint32_t ticks) {
+        now += ticks;
+    }
+    /** Called with each new move. Returns false if the move has to wait
+    until all delayed steps are executed. */
+    static INLINE bool startMove(bool unshaped) {
+        if(unshaped || (x.numEchos == 0 && y.numEchos == 0)) {
+            if(!isIdle()) return false;
+            active = false;
+        } else active = true;
+        return true;
+    }
+    /** Sets direction pins for unshaped moves. Shaped moves change direction when needed. */
+    static INLINE void setDirection(bool xPositive, bool yPositive) {
+        if(active) return;
+        Printer::setXDirection(xPositive);
+        Printer::setYDirection(yPositive);
+        x.positive = xPositive;
+        y.positive = yPositive;
+    }
+    /** Executes due delayed steps and starts the step pulses for x and y.
+    A direction change only sets the pin, the step follows at the next call
+    so the driver sees the direction before the step. */
+    static INLINE void step() {
+        x.processEchos(now);
+        fast8_t s = x.pendingStep();
+        if(s) {
+            if((s > 0) == x.positive) {
+                Printer::startXStep();
+                x.residual -= s > 0 ? INPUT_SHAPER_ONE : -INPUT_SHAPER_ONE;
+            } else {
+                x.positive = s > 0;
+                Printer::setXDirection(x.positive);
+            }
+        }
+        y.processEchos(now);
+        s = y.pendingStep();
+        if(s) {
+            if((s > 0) == y.positive) {
+                Printer::startYStep();
+                y.residual -= s > 0 ? INPUT_SHAPER_ONE : -INPUT_SHAPER_ONE;
+            } else {
+                y.positive = s > 0;
+                Printer::setYDirection(y.positive);
+            }
+        }
+    }
+    static uint32_t idleStep(uint32_t maxWait);
+    static void updateDerived();
+    static void reportStatus();
+};
+#endif // INPUT_SHAPING
+
+#endif
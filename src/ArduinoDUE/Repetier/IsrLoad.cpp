@@ -0,0 +1,144 @@
+/*
+    This file is part of Repetier-Firmware.
+
+    Repetier-Firmware is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Repetier-Firmware is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Repetier-Firmware.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#include "Repetier.h"
+
+#if ISR_LOAD_STATISTICS
+
+IsrTimer IsrLoad::stepper, IsrLoad::pwm, IsrLoad::extruder;
+uint32_t IsrLoad::windowStart = 0;
+uint32_t IsrLoad::lastOverruns = 0;
+
+void IsrTimer::reset() {
+    InterruptProtectedBlock noInts;
+    calls = overruns = maxCycles = windowCycles = 0;
+    minCycles = 0xffffffffUL;
+    totalCycles = 0;
+    load = peakLoad = 0;
+}
+
+void IsrTimer::closeWindow(uint32_t elapsed) {
+    InterruptProtectedBlock noInts;
+    uint32_t cycles = windowCycles;
+    windowCycles = 0;
+    noInts.unprotect();
+    totalCycles += cycles;
+    uint64_t percent = elapsed ? static_cast<uint64_t>(cycles) * 100 / elapsed : 0;
+    load = percent > 100 ? 100 : static_cast<uint8_t>(percent);
+    if(load > peakLoad)
+        peakLoad = load;
+}
+
+void IsrTimer::report(FSTRINGPARAM(name)) {
+    InterruptProtectedBlock noInts;
+    uint32_t n = calls; // calls also counts the running window, so its cycles belong to the average
+    uint64_t cycles = totalCycles + windowCycles;
+    noInts.unprotect();
+    Com::printF(name);
+    Com::printF(PSTR(" calls:"), n);
+    Com::printF(PSTR(" min:"), n ? minCycles : 0);
+    Com::printF(PSTR(" avg:"), n ? static_cast<uint32_t>(cycles / n) : 0);
+    Com::printF(PSTR(" max:"), maxCycles);
+    Com::printF(PSTR(" load:"), (int)load);
+    Com::printF(PSTR("% peak:"), (int)peakLoad);
+    Com::printF(PSTR("%"));
+    if(&IsrLoad::stepper == this)
+        Com::printF(PSTR(" overruns:"), overruns);
+    Com::println();
+}
+
+/** Called every 500ms from Commands::checkForPeriodicalActions. */
+void IsrLoad::update() {
+    uint32_t now = HAL::cycleCounter();
+    uint32_t elapsed = now - windowStart;
+    windowStart = now;
+    stepper.closeWindow(elapsed);
+    pwm.closeWindow(elapsed);
+    extruder.closeWindow(elapsed);
+    uint32_t overruns = stepper.overruns;
+    bool overrun = overruns != lastOverruns;
+    lastOverruns = overruns;
+#if ISR_LOAD_ADAPTIVE
+    if(!overrun && stepper.load < ISR_LOAD_ADAPTIVE_MAX)
+        return;
+    bool adapted = false;
+    if(Printer::stepDoublerFrequency > STEP_DOUBLER_FREQUENCY / 2) {
+        Printer::stepDoublerFrequency -= Printer::stepDoublerFrequency >> 3;
+        adapted = true;
+    }
+#if NONLINEAR_SYSTEM
+    if(Printer::printMovesPerSecond > 15) {
+        Printer::printMovesPerSecond -= (Printer::printMovesPerSecond >> 3) + 1;
+        if(Printer::printMovesPerSecond < 15) Printer::printMovesPerSecond = 15;
+        adapted = true;
+    }
+    if(Printer::travelMovesPerSecond > 15) {
+        Printer::travelMovesPerSecond -= (Printer::travelMovesPerSecond >> 3) + 1;
+        if(Printer::travelMovesPerSecond < 15) Printer::travelMovesPerSecond = 15;
+        adapted = true;
+    }
+#endif
+    if(adapted) {
+        Com::printF(PSTR("Stepper load:"), (int)stepper.load);
+        Com::printF(PSTR("% step doubler frequency:"), (int32_t)Printer::stepDoublerFrequency);
+#if NONLINEAR_SYSTEM
+        Com::printF(PSTR(" segments/s:"), Printer::printMovesPerSecond);
+#endif
+        Com::println();
+    }
+#else
+    (void)overrun;
+#endif
+}
+
+void IsrLoad::reset() {
+    stepper.reset();
+    pwm.reset();
+    extruder.reset();
+    lastOverruns = 0;
+    windowStart = HAL::cycleCounter();
+#if ISR_LOAD_ADAPTIVE
+    Printer::stepDoublerFrequency = STEP_DOUBLER_FREQUENCY;
+#if NONLINEAR_SYSTEM
+    Printer::travelMovesPerSecond = EEPROM::deltaSegmentsPerSecondMove();
+    Printer::printMovesPerSecond = EEPROM::deltaSegmentsPerSecondPrint();
+    if(Printer::travelMovesPerSecond < 15) Printer::travelMovesPerSecond = 15;
+    if(Printer::printMovesPerSecond < 15) Printer::printMovesPerSecond = 15;
+#endif
+#endif
+}
+
+void IsrLoad::report() {
+    stepper.report(PSTR("ISR stepper"));
+    pwm.report(PSTR("ISR pwm"));
+    extruder.report(PSTR("ISR extruder"));
+#if ISR_LOAD_ADAPTIVE
+    Com::printFLN(PSTR("Step doubler frequency:"), (int32_t)Printer::stepDoublerFrequency);
+#endif
+}
+
+void IsrLoad::reportJSON() {
+    Com::printF(PSTR(",\"isrLoad\":{\"stepper\":"), (int)stepper.load);
+    Com::printF(PSTR(",\"pwm\":"), (int)pwm.load);
+    Com::printF(PSTR(",\"extruder\":"), (int)extruder.load);
+    Com::printF(PSTR(",\"stepperMaxCycles\":"), stepper.maxCycles);
+    Com::printF(PSTR(",\"overruns\":"), stepper.overruns);
+    Com::print('}');
+}
+
+#endif
@@ -38,13 +38,13 @@ float Printer::axisX2StepsPerMM = X2AXIS_STEPS_PER_MM;
 float Printer::maxAccelerationMMPerSquareSecond[E_AXIS_ARRAY] = {MAX_ACCELERATION_UNITS_PER_SQ_SECOND_X, MAX_ACCELERATION_UNITS_PER_SQ_SECOND_Y, MAX_ACCELERATION_UNITS_PER_SQ_SECOND_Z}; ///< X, Y, Z and E max acceleration in mm/s^2 for printing moves or retracts
 float Printer::maxTravelAccelerationMMPerSquareSecond[E_AXIS_ARRAY] = {MAX_TRAVEL_ACCELERATION_UNITS_PER_SQ_SECOND_X, MAX_TRAVEL_ACCELERATION_UNITS_PER_SQ_SECOND_Y, MAX_TRAVEL_ACCELERATION_UNITS_PER_SQ_SECOND_Z}; ///< X, Y, Z max acceleration in mm/s^2 for travel moves
 /** Acceleration in steps/s^3 in printing mode.*/
-unsigned long Printer::maxPrintAccelerationStepsPerSquareSecond[E_AXIS_ARRAY];
+uint32_t Printer::maxPrintAccelerationStepsPerSquareSecond[E_AXIS_ARRAY];
 /** Acceleration in steps/s^2 in movement mode.*/
-unsigned long Printer::maxTravelAccelerationStepsPerSquareSecond[E_AXIS_ARRAY];
+uint32_t Printer::maxTravelAccelerationStepsPerSquareSecond[E_AXIS_ARRAY];
 // uint32_t Printer::maxInterval;
 #endif
 #if NONLINEAR_SYSTEM
-long Printer::currentNonlinearPositionSteps[E_TOWER_ARRAY];
+int32_t Printer::currentNonlinearPositionSteps[E_TOWER_ARRAY];
 uint8_t lastMoveID = 0; // Last move ID
 #endif
 #if DRIVE_SYSTEM != DELTA
@@ -57,10 +57,10 @@ int16_t Printer::zBabysteps = 0;
 uint8_t Printer::relativeCoordinateMode = false;  ///< Determines absolute (false) or relative Coordinates (true).
 uint8_t Printer::relativeExtruderCoordinateMode = false;  ///< Determines Absolute or Relative E Codes while in Absolute Coordinates mode. E is always relative in Relative Coordinates mode.
 
-long Printer::currentPositionSteps[E_AXIS_ARRAY];
+int32_t Printer::currentPositionSteps[E_AXIS_ARRAY];
 float Printer::currentPosition[Z_AXIS_ARRAY];
 float Printer::lastCmdPos[Z_AXIS_ARRAY];
-long Printer::destinationSteps[E_AXIS_ARRAY];
+int32_t Printer::destinationSteps[E_AXIS_ARRAY];
 float Printer::coordinateOffset[Z_AXIS_ARRAY] = {0, 0, 0};
 uint8_t Printer::flag0 = 0;
 uint8_t Printer::flag1 = 0;
@@ -96,6 +96,9 @@ uint32_t Printer::stepNumber;         ///< Step number in current move.
 int32_t Printer::advanceExecuted;             ///< Executed advance steps
 #endif
 int Printer::advanceStepsSet;
+#if PLANNER_ADVANCE
+int32_t Printer::advanceSmoothed;
+#endif
 #endif
 #if NONLINEAR_SYSTEM
 int32_t Printer::maxDeltaPositionSteps;
@@ -149,6 +152,9 @@ float Printer::feedrate;                   ///< Last requested feedrate.
 int Printer::feedrateMultiply;             ///< Multiplier for feedrate in percent (factor 1 = 100)
 unsigned int Printer::extrudeMultiply;     ///< Flow multiplier in percent (factor 1 = 100)
 float Printer::maxJerk;                    ///< Maximum allowed jerk in mm/s
+#if JUNCTION_DEVIATION
+float Printer::junctionDeviation;          ///< Maximum distance in mm between corner path and junction
+#endif
 #if DRIVE_SYSTEM != DELTA
 float Printer::maxZJerk;                   ///< Maximum allowed jerk in z direction in mm/s
 #endif
@@ -157,6 +163,9 @@ float Printer::offsetY;                     ///< Y-offset for different extruder
 float Printer::offsetZ;                     ///< Z-offset for different extruder positions.
 float Printer::offsetZ2 = 0;                ///< Z-offset without rotation correction.
 speed_t Printer::vMaxReached;               ///< Maximum reached speed
+#if ISR_LOAD_ADAPTIVE
+speed_t Printer::stepDoublerFrequency = STEP_DOUBLER_FREQUENCY;
+#endif
 uint32_t Printer::msecondsPrinting;         ///< Milliseconds of printing time (means time with heated extruder)
 float Printer::filamentPrinted;             ///< mm of filament printed since counting started
 #if ENABLE_BACKLASH_COMPENSATION
@@ -434,7 +443,7 @@ void Printer::updateDerivedParameter() {
         deltaDiagonalStepsSquaredC.l = RMath::sqr(deltaDiagonalStepsSquaredC.l);
     }
     deltaMaxRadiusSquared = RMath::sqr(EEPROM::deltaMaxRadius());
-    long cart[Z_AXIS_ARRAY], delta[TOWER_ARRAY];
+    int32_t cart[Z_AXIS_ARRAY], delta[TOWER_ARRAY];
     cart[X_AXIS] = cart[Y_AXIS] = 0;
     cart[Z_AXIS] = zMaxSteps;
     transformCartesianStepsToDeltaSteps(cart, delta);
@@ -561,6 +570,10 @@ void Printer::enablePowerIfNeeded() {
 */
 void Printer::kill(uint8_t onlySteppers) {
     EVENT_KILL(onlySteppers);
+#if GCODE_MOVE_RING_SIZE > 0
+    if(!onlySteppers)
+        GCodeMoveRing::reset();
+#endif
     if(areAllSteppersDisabled() && onlySteppers) return;
     if(Printer::isAllKilled()) return;
 #if defined(NUM_MOTOR_DRIVERS) && NUM_MOTOR_DRIVERS > 0
@@ -744,9 +757,11 @@ uint8_t Printer::setDestinationStepsFromGCode(GCode *com) {
     register int32_t p;
     float x, y, z;
     bool posAllowed = true;
+    bool relative = relativeCoordinateMode && !com->absolutePosition;
+    bool relativeE = (relativeCoordinateMode || relativeExtruderCoordinateMode) && !com->absolutePosition;
 #if FEATURE_RETRACTION
     if(com->hasNoXYZ() && com->hasE() && isAutoretract()) { // convert into auto retract
-        if(relativeCoordinateMode || relativeExtruderCoordinateMode) {
+        if(relativeE) {
             Extruder::current->retract(com->E < 0, false);
         } else {
             p = convertToMM(com->E * axisStepsPerMM[E_AXIS]); // target position
@@ -774,7 +789,7 @@ uint8_t Printer::setDestinationStepsFromGCode(GCode *com) {
 #if DISTORTION_CORRECTION == 0
     if(!com->hasNoXYZ()) {
 #endif
-        if(!relativeCoordinateMode) {
+        if(!relative) {
             if(com->hasX()) lastCmdPos[X_AXIS] = currentPosition[X_AXIS] = convertToMM(com->X) - coordinateOffset[X_AXIS];
             if(com->hasY()) lastCmdPos[Y_AXIS] = currentPosition[Y_AXIS] = convertToMM(com->Y) - coordinateOffset[Y_AXIS];
             if(com->hasZ()) lastCmdPos[Z_AXIS] = currentPosition[Z_AXIS] = convertToMM(com->Z) - coordinateOffset[Z_AXIS];
@@ -804,7 +819,7 @@ uint8_t Printer::setDestinationStepsFromGCode(GCode *com) {
 #endif
     if(com->hasE() && !Printer::debugDryrun()) {
         p = convertToMM(com->E * axisStepsPerMM[E_AXIS]);
-        if(relativeCoordinateMode || relativeExtruderCoordinateMode) {
+        if(relativeE) {
             if(
 #if MIN_EXTRUDER_TEMP > 20
                 (Extruder::current->tempControl.currentTemperatureC < MIN_EXTRUDER_TEMP && !Printer::isColdExtrusionAllowed() && Extruder::current->tempControl.sensorType != 0) ||
@@ -1181,8 +1196,14 @@ void Printer::setup() {
     advanceExecuted = 0;
 #endif
     advanceStepsSet = 0;
+#if PLANNER_ADVANCE
+    advanceSmoothed = 0;
+#endif
 #endif
     maxJerk = MAX_JERK;
+#if JUNCTION_DEVIATION
+    junctionDeviation = JUNCTION_DEVIATION_DISTANCE;
+#endif
 #if DRIVE_SYSTEM != DELTA
     maxZJerk = MAX_ZJERK;
 #endif
@@ -1218,11 +1239,21 @@ void Printer::setup() {
 #endif //(MOTHERBOARD == 501) || (MOTHERBOARD == 502)
     EEPROM::initBaudrate();
     HAL::serialSetBaudrate(baudrate);
+#if SERIAL_USB_SOURCE
+    SerialUSB.begin(baudrate);
+    GCodeSource::registerSource(&usbSource);
+#endif
     Com::printFLN(Com::tStart);
     HAL::showStartReason();
     Extruder::initExtruder();
     // sets auto leveling in eeprom init
     EEPROM::init(); // Read settings from eeprom if wanted
+#if DYNAMIC_PRINTLINE_CACHE
+    PrintLine::allocateCache();
+#endif
+#if INPUT_SHAPING
+    InputShaper::updateDerived(); // Without EEPROM settings come from configuration
+#endif
     UI_INITIALIZE;
     for(uint8_t i = 0; i < E_AXIS_ARRAY; i++) {
         currentPositionSteps[i] = 0;
@@ -1237,6 +1268,9 @@ void Printer::setup() {
     Commands::checkFreeMemory();
     Commands::writeLowestFreeRAM();
     HAL::setupTimer();
+#if ISR_LOAD_STATISTICS
+    IsrLoad::reset();
+#endif
 
 #if FEATURE_WATCHDOG
     HAL::startWatchdog();
@@ -1403,10 +1437,10 @@ void Printer::homeZAxis() { // Delta z homing
     // These can be adjusted by two methods. You can use offsets stored by determining the center
     // or you can use the xyzMinSteps from G100 calibration. Both have the same effect but only one
     // should be measured as both have the same effect.
-    long dx = -xMinSteps - EEPROM::deltaTowerXOffsetSteps();
-    long dy = -yMinSteps - EEPROM::deltaTowerYOffsetSteps();
-    long dz = -zMinSteps - EEPROM::deltaTowerZOffsetSteps();
-    long dm = RMath::min(dx, dy, dz);
+    int32_t dx = -xMinSteps - EEPROM::deltaTowerXOffsetSteps();
+    int32_t dy = -yMinSteps - EEPROM::deltaTowerYOffsetSteps();
+    int32_t dz = -zMinSteps - EEPROM::deltaTowerZOffsetSteps();
+    int32_t dm = RMath::min(dx, dy, dz);
     //Com::printFLN(Com::tTower1,dx);
     //Com::printFLN(Com::tTower2,dy);
     //Com::printFLN(Com::tTower3,dz);
@@ -2209,8 +2243,11 @@ void Printer::showConfiguration() {
     Com::config(PSTR("ZProbe:"), FEATURE_Z_PROBE);
     Com::config(PSTR("Autolevel:"), FEATURE_AUTOLEVEL);
     Com::config(PSTR("EEPROM:"), EEPROM_MODE != 0);
-    Com::config(PSTR("PrintlineCache:"), PRINTLINE_CACHE_SIZE);
+    Com::config(PSTR("PrintlineCache:"), (int)PrintLine::getCacheSize());
     Com::config(PSTR("JerkXY:"), maxJerk);
+#if JUNCTION_DEVIATION
+    Com::config(PSTR("JunctionDeviation:"), junctionDeviation);
+#endif
     Com::config(PSTR("KeepAliveInterval:"), KEEP_ALIVE_INTERVAL);
 #if DRIVE_SYSTEM != DELTA
     Com::config(PSTR("JerkZ:"), maxZJerk);
@@ -2459,6 +2496,9 @@ void Printer::showJSONStatus(int type) {
     }
     Com::printF(PSTR("]}},\"time\":"));
     Com::print(HAL::timeInMilliseconds());
+#if ISR_LOAD_STATISTICS
+    IsrLoad::reportJSON();
+#endif
 
     switch (type) {
     default:
@@ -252,6 +252,9 @@ public:
     static ufast8_t maxExtruderSpeed;            ///< Timer delay for end extruder speed
     //static uint8_t extruderAccelerateDelay;     ///< delay between 2 speec increases
     static int advanceStepsSet;
+#if PLANNER_ADVANCE || defined(DOXYGEN)
+    static int32_t advanceSmoothed;          ///< Smoothed advance in steps * 65536
+#endif
 #if ENABLE_QUADRATIC_ADVANCE || defined(DOXYGEN)
     static long advanceExecuted;             ///< Executed advance steps
 #endif
@@ -268,8 +271,8 @@ public:
     // static uint32_t maxInterval; // slowest allowed interval
     static float maxAccelerationMMPerSquareSecond[];
     static float maxTravelAccelerationMMPerSquareSecond[];
-    static unsigned long maxPrintAccelerationStepsPerSquareSecond[];
-    static unsigned long maxTravelAccelerationStepsPerSquareSecond[];
+    static uint32_t maxPrintAccelerationStepsPerSquareSecond[];
+    static uint32_t maxTravelAccelerationStepsPerSquareSecond[];
     static uint8_t relativeCoordinateMode;    ///< Determines absolute (false) or relative Coordinates (true).
     static uint8_t relativeExtruderCoordinateMode;  ///< Determines Absolute or Relative E Codes while in Absolute Coordinates mode. E is always relative in Relative Coordinates mode.
 
@@ -361,6 +364,9 @@ public:
     static int feedrateMultiply;             ///< Multiplier for feedrate in percent (factor 1 = 100)
     static unsigned int extrudeMultiply;     ///< Flow multiplier in percent (factor 1 = 100)
     static float maxJerk;                    ///< Maximum allowed jerk in mm/s
+#if JUNCTION_DEVIATION || defined(DOXYGEN)
+    static float junctionDeviation;          ///< Maximum distance in mm between corner path and junction
+#endif
     static uint8_t interruptEvent;           ///< Event generated in interrupts that should/could be handled in main thread
 #if DRIVE_SYSTEM!=DELTA || defined(DOXYGEN)
     static float maxZJerk;                   ///< Maximum allowed jerk in z direction in mm/s
@@ -370,6 +376,9 @@ public:
     static float offsetZ;                     ///< Z-offset for different tool positions.
     static float offsetZ2;                    ///< Z-offset without rotation correction. Required for z probe corrections
     static speed_t vMaxReached;               ///< Maximum reached speed
+#if ISR_LOAD_ADAPTIVE
+    static speed_t stepDoublerFrequency;      ///< STEP_DOUBLER_FREQUENCY lowered by stepper load
+#endif
     static uint32_t msecondsPrinting;         ///< Milliseconds of printing time (means time with heated extruder)
     static float filamentPrinted;             ///< mm of filament printed since counting started
 #if ENABLE_BACKLASH_COMPENSATION || defined(DOXYGEN)
@@ -1045,6 +1054,85 @@ public:
 #endif
 #endif
     }
+#if STEP_PORT_PARALLEL || defined(DOXYGEN)
+    /** Step pins of the axes set in axes (XSTEP, YSTEP, ZSTEP) that are on port. The port
+    tests are constant, so only ports with step pins are left over after compilation.
+    allMotors ignores the motors stopped by multiple endstop homing. */
+    static INLINE uint32_t stepPinMask(Pio *port, uint8_t axes, bool allMotors) {
+        uint32_t mask = 0;
+        if(axes & XSTEP) {
+#if MULTI_XENDSTOP_HOMING
+            if(allMotors || (multiXHomeFlags & 1))
+#endif
+                mask |= PIN_ON_PORT(X_STEP_PIN, port);
+#if FEATURE_TWO_XSTEPPER
+#if MULTI_XENDSTOP_HOMING
+            if(allMotors || (multiXHomeFlags & 2))
+#endif
+                mask |= PIN_ON_PORT(X2_STEP_PIN, port);
+#endif
+        }
+        if(axes & YSTEP) {
+#if MULTI_YENDSTOP_HOMING
+            if(allMotors || (multiYHomeFlags & 1))
+#endif
+                mask |= PIN_ON_PORT(Y_STEP_PIN, port);
+#if FEATURE_TWO_YSTEPPER
+#if MULTI_YENDSTOP_HOMING
+            if(allMotors || (multiYHomeFlags & 2))
+#endif
+                mask |= PIN_ON_PORT(Y2_STEP_PIN, port);
+#endif
+        }
+        if(axes & ZSTEP) {
+#if MULTI_ZENDSTOP_HOMING
+            if(allMotors || (multiZHomeFlags & 1))
+#endif
+                mask |= PIN_ON_PORT(Z_STEP_PIN, port);
+#if FEATURE_TWO_ZSTEPPER
+#if MULTI_ZENDSTOP_HOMING
+            if(allMotors || (multiZHomeFlags & 2))
+#endif
+                mask |= PIN_ON_PORT(Z2_STEP_PIN, port);
+#endif
+#if FEATURE_THREE_ZSTEPPER
+#if MULTI_ZENDSTOP_HOMING
+            if(allMotors || (multiZHomeFlags & 4))
+#endif
+                mask |= PIN_ON_PORT(Z3_STEP_PIN, port);
+#endif
+#if FEATURE_FOUR_ZSTEPPER
+#if MULTI_ZENDSTOP_HOMING
+            if(allMotors || (multiZHomeFlags & 8))
+#endif
+                mask |= PIN_ON_PORT(Z4_STEP_PIN, port);
+#endif
+        }
+        return mask;
+    }
+    static INLINE void writeStepPort(Pio *port, uint32_t mask, bool high) {
+        if(mask) {
+            if(high)
+                port->PIO_SODR = mask;
+            else
+                port->PIO_CODR = mask;
+        }
+    }
+    /** Starts the steps of all axes set in axes with one write per port, so all
+    motors see the step edge at the same time. */
+    static INLINE void startXYZSteps(uint8_t axes) {
+        writeStepPort(PIOA, stepPinMask(PIOA, axes, false), START_STEP_WITH_HIGH);
+        writeStepPort(PIOB, stepPinMask(PIOB, axes, false), START_STEP_WITH_HIGH);
+        writeStepPort(PIOC, stepPinMask(PIOC, axes, false), START_STEP_WITH_HIGH);
+        writeStepPort(PIOD, stepPinMask(PIOD, axes, false), START_STEP_WITH_HIGH);
+    }
+    static INLINE void endXYZSteps() {
+        writeStepPort(PIOA, stepPinMask(PIOA, XSTEP | YSTEP | ZSTEP, true), !START_STEP_WITH_HIGH);
+        writeStepPort(PIOB, stepPinMask(PIOB, XSTEP | YSTEP | ZSTEP, true), !START_STEP_WITH_HIGH);
+        writeStepPort(PIOC, stepPinMask(PIOC, XSTEP | YSTEP | ZSTEP, true), !START_STEP_WITH_HIGH);
+        writeStepPort(PIOD, stepPinMask(PIOD, XSTEP | YSTEP | ZSTEP, true), !START_STEP_WITH_HIGH);
+    }
+#else
     static INLINE void endXYZSteps() {
         WRITE(X_STEP_PIN, !START_STEP_WITH_HIGH);
 #if FEATURE_TWO_XSTEPPER || DUAL_X_AXIS
@@ -1065,10 +1153,11 @@ public:
         WRITE(Z4_STEP_PIN, !START_STEP_WITH_HIGH);
 #endif
     }
+#endif
     static INLINE speed_t updateStepsPerTimerCall(speed_t vbase) {
-        if(vbase > STEP_DOUBLER_FREQUENCY) {
+        if(vbase > STEP_DOUBLER_LIMIT) {
 #if ALLOW_QUADSTEPPING
-            if(vbase > STEP_DOUBLER_FREQUENCY * 2) {
+            if(vbase > STEP_DOUBLER_LIMIT * 2) {
                 Printer::stepsPerTimerCall = 4;
                 return vbase >> 2;
             } else {
@@ -260,6 +260,58 @@ typedef uint8_t secondspeed_t;
 #define MAX_JERK_DISTANCE 0.6
 #endif
 
+#ifndef JUNCTION_DEVIATION
+#define JUNCTION_DEVIATION 0
+#endif
+#ifndef JUNCTION_DEVIATION_DISTANCE
+#define JUNCTION_DEVIATION_DISTANCE 0.02
+#endif
+#ifndef JUNCTION_ARC_SEGMENTS
+#define JUNCTION_ARC_SEGMENTS 4
+#endif
+#ifndef JUNCTION_ARC_TOLERANCE
+#define JUNCTION_ARC_TOLERANCE 0.05
+#endif
+
+#ifndef INCREMENTAL_PLANNER
+#define INCREMENTAL_PLANNER 0
+#endif
+#ifndef INCREMENTAL_PLANNER_TOLERANCE
+#define INCREMENTAL_PLANNER_TOLERANCE 0.02
+#endif
+
+#ifndef DYNAMIC_PRINTLINE_CACHE
+#define DYNAMIC_PRINTLINE_CACHE 0
+#endif
+#if DYNAMIC_PRINTLINE_CACHE && CPU_ARCH != ARCH_ARM
+#undef DYNAMIC_PRINTLINE_CACHE // static cache uses less RAM and index computation is faster
+#define DYNAMIC_PRINTLINE_CACHE 0
+#endif
+#ifndef PRINTLINE_CACHE_SIZE_MAX
+#define PRINTLINE_CACHE_SIZE_MAX 64
+#endif
+
+#ifndef FIXED_POINT_PLANNER
+#define FIXED_POINT_PLANNER 0
+#endif
+#if FIXED_POINT_PLANNER
+#define PLANNER_SPEED_SCALE 16
+typedef uint16_t planner_speed_t;  // mm/s * PLANNER_SPEED_SCALE
+typedef uint32_t planner_speed2_t; // mm^2/s^2 * PLANNER_SPEED_SCALE^2
+#else
+#define PLANNER_SPEED_SCALE 1
+typedef float planner_speed_t;
+typedef float planner_speed2_t;
+#endif
+
+#ifndef S_CURVE_ACCELERATION
+#define S_CURVE_ACCELERATION 0
+#endif
+#if S_CURVE_ACCELERATION && !RAMP_ACCELERATION
+#undef S_CURVE_ACCELERATION
+#define S_CURVE_ACCELERATION 0
+#endif
+
 #if defined(FAST_COREXYZ) && !(DRIVE_SYSTEM==XY_GANTRY || DRIVE_SYSTEM==YX_GANTRY || DRIVE_SYSTEM==XZ_GANTRY || DRIVE_SYSTEM==ZX_GANTRY || DRIVE_SYSTEM==GANTRY_FAKE)
 #undef FAST_COREXYZ
 #endif
@@ -322,6 +374,41 @@ inline void memcopy4(void *dest,void *source) {
 #define MICROSTEP32 HIGH,HIGH
 
 #define GCODE_BUFFER_SIZE 1
+#ifndef GCODE_MOVE_RING_SIZE
+#define GCODE_MOVE_RING_SIZE 0
+#endif
+#ifndef ACK_WINDOW
+#define ACK_WINDOW 0
+#endif
+#if ACK_WINDOW > 255
+#undef ACK_WINDOW
+#define ACK_WINDOW 255
+#endif
+#ifndef REALTIME_COMMANDS
+#define REALTIME_COMMANDS 0
+#endif
+#ifndef FEATURE_BINARY_V3
+#define FEATURE_BINARY_V3 0
+#endif
+#define BINARY_V3_XYZ_UNITS 1000.0f // units per mm of version 3 move batches
+#define BINARY_V3_E_UNITS 10000.0f
+#ifndef SERIAL_USB_SOURCE
+#define SERIAL_USB_SOURCE 0
+#endif
+#ifndef SERIAL_USB_BUFFER_SIZE
+#define SERIAL_USB_BUFFER_SIZE 1024
+#endif
+#if SERIAL_USB_SOURCE && ((SERIAL_USB_BUFFER_SIZE & (SERIAL_USB_BUFFER_SIZE - 1)) != 0 || SERIAL_USB_BUFFER_SIZE > 32768)
+#error SERIAL_USB_BUFFER_SIZE must be a power of 2 and at most 32768
+#endif
+
+#if GCODE_MOVE_RING_SIZE > 0 && GCODE_MOVE_RING_SIZE < 128
+#undef GCODE_MOVE_RING_SIZE
+#define GCODE_MOVE_RING_SIZE 128
+#elif GCODE_MOVE_RING_SIZE > 32768
+#undef GCODE_MOVE_RING_SIZE
+#define GCODE_MOVE_RING_SIZE 32768
+#endif
 
 #ifndef FEATURE_BABYSTEPPING
 #define FEATURE_BABYSTEPPING 0
@@ -387,6 +474,90 @@ inline void memcopy4(void *dest,void *source) {
 
 #define GANTRY ( DRIVE_SYSTEM==XY_GANTRY || DRIVE_SYSTEM==YX_GANTRY || DRIVE_SYSTEM==XZ_GANTRY || DRIVE_SYSTEM==ZX_GANTRY || DRIVE_SYSTEM==GANTRY_FAKE)
 
+#ifndef STEP_BATCHING
+#define STEP_BATCHING 0
+#endif
+#if STEP_BATCHING && (NONLINEAR_SYSTEM || GANTRY)
+#undef STEP_BATCHING // gantry steps are combined in the Bresenham loop
+#define STEP_BATCHING 0
+#endif
+#ifndef STEP_AXIS_TIMING
+#define STEP_AXIS_TIMING 0
+#endif
+#if STEP_AXIS_TIMING && (CPU_ARCH == ARCH_AVR || NONLINEAR_SYSTEM || GANTRY)
+#undef STEP_AXIS_TIMING // needs a division per step and one motor per axis
+#define STEP_AXIS_TIMING 0
+#endif
+#if STEP_AXIS_TIMING && !STEP_BATCHING
+#undef STEP_BATCHING // scheduled steps are executed by the batch replay
+#define STEP_BATCHING 1
+#endif
+#ifndef STEP_AXIS_TIMING_MIN_TICKS
+#define STEP_AXIS_TIMING_MIN_TICKS (F_CPU / 300000)
+#endif
+#ifndef PLANNER_ADVANCE
+#define PLANNER_ADVANCE 0
+#endif
+#if PLANNER_ADVANCE && !USE_ADVANCE
+#undef PLANNER_ADVANCE
+#define PLANNER_ADVANCE 0
+#endif
+#if PLANNER_ADVANCE && ENABLE_QUADRATIC_ADVANCE
+#undef ENABLE_QUADRATIC_ADVANCE // planner advance is linear only
+#define ENABLE_QUADRATIC_ADVANCE 0
+#endif
+#ifndef ADVANCE_SMOOTH_TIME
+#define ADVANCE_SMOOTH_TIME 40
+#endif
+#define ADVANCE_SMOOTH_TICKS (F_CPU / 1000 * ADVANCE_SMOOTH_TIME)
+// Advance steps are executed by an own extruder timer interrupt
+#define ADVANCE_EXTRUDER_TIMER (USE_ADVANCE && !PLANNER_ADVANCE)
+#ifndef STEP_PORT_PARALLEL
+#define STEP_PORT_PARALLEL 0
+#endif
+#if STEP_PORT_PARALLEL && (GANTRY || DUAL_X_AXIS)
+#undef STEP_PORT_PARALLEL // steps are not set per axis
+#define STEP_PORT_PARALLEL 0
+#endif
+#ifndef ISR_LOAD_STATISTICS
+#define ISR_LOAD_STATISTICS 0
+#endif
+#ifndef ISR_LOAD_ADAPTIVE
+#define ISR_LOAD_ADAPTIVE 0
+#endif
+#ifndef ISR_LOAD_ADAPTIVE_MAX
+#define ISR_LOAD_ADAPTIVE_MAX 70
+#endif
+#ifndef INPUT_SHAPING
+#define INPUT_SHAPING 0
+#endif
+#if INPUT_SHAPING && (NONLINEAR_SYSTEM || GANTRY || DUAL_X_AXIS || !RAMP_ACCELERATION)
+#undef INPUT_SHAPING // x and y motor must move exactly one axis each
+#define INPUT_SHAPING 0
+#endif
+#ifndef INPUT_SHAPER_TYPE
+#define INPUT_SHAPER_TYPE 0
+#endif
+#ifndef INPUT_SHAPER_FREQUENCY_X
+#define INPUT_SHAPER_FREQUENCY_X 0
+#endif
+#ifndef INPUT_SHAPER_FREQUENCY_Y
+#define INPUT_SHAPER_FREQUENCY_Y 0
+#endif
+#ifndef INPUT_SHAPER_DAMPING_X
+#define INPUT_SHAPER_DAMPING_X 0.1
+#endif
+#ifndef INPUT_SHAPER_DAMPING_Y
+#define INPUT_SHAPER_DAMPING_Y 0.1
+#endif
+#ifndef INPUT_SHAPER_QUEUE_SIZE
+#if CPU_ARCH == ARCH_AVR
+#define INPUT_SHAPER_QUEUE_SIZE 128
+#else
+#define INPUT_SHAPER_QUEUE_SIZE 1024
+#endif
+#endif
+
 //Step to split a circle in small Lines
 #ifndef MM_PER_ARC_SEGMENT
 #define MM_PER_ARC_SEGMENT 1
@@ -396,6 +567,13 @@ inline void memcopy4(void *dest,void *source) {
 #endif
 //After this count of steps a new SIN / COS calculation is started to correct the circle interpolation
 #define N_ARC_CORRECTION 25
+#ifndef ARC_NATIVE
+#define ARC_NATIVE 0
+#endif
+#if ARC_NATIVE && (!ARC_SUPPORT || NONLINEAR_SYSTEM || GANTRY || DUAL_X_AXIS)
+#undef ARC_NATIVE // x and y motor must move exactly one axis each
+#define ARC_NATIVE 0
+#endif
 
 // Test for shared cooler
 #if NUM_EXTRUDER == 6 && EXT0_EXTRUDER_COOLER_PIN > -1 && EXT0_EXTRUDER_COOLER_PIN == EXT1_EXTRUDER_COOLER_PIN && EXT2_EXTRUDER_COOLER_PIN == EXT3_EXTRUDER_COOLER_PIN && EXT4_EXTRUDER_COOLER_PIN == EXT5_EXTRUDER_COOLER_PIN && EXT0_EXTRUDER_COOLER_PIN == EXT2_EXTRUDER_COOLER_PIN && EXT0_EXTRUDER_COOLER_PIN == EXT4_EXTRUDER_COOLER_PIN
@@ -595,6 +773,23 @@ inline void memcopy4(void *dest,void *source) {
 #endif
 
 #include "HAL.h"
+#if STEP_PORT_PARALLEL && !defined(PIN_ON_PORT)
+#undef STEP_PORT_PARALLEL // HAL has no port access
+#define STEP_PORT_PARALLEL 0
+#endif
+#if ISR_LOAD_STATISTICS && !defined(HAL_CYCLE_COUNTER)
+#undef ISR_LOAD_STATISTICS // HAL has no cycle counter
+#define ISR_LOAD_STATISTICS 0
+#endif
+#if ISR_LOAD_ADAPTIVE && !ISR_LOAD_STATISTICS
+#undef ISR_LOAD_ADAPTIVE
+#define ISR_LOAD_ADAPTIVE 0
+#endif
+#if ISR_LOAD_ADAPTIVE
+#define STEP_DOUBLER_LIMIT Printer::stepDoublerFrequency
+#else
+#define STEP_DOUBLER_LIMIT STEP_DOUBLER_FREQUENCY
+#endif
 #define MAX_VFAT_ENTRIES (2)
 /** Total size of the buffer used to store the long filenames */
 #define LONG_FILENAME_LENGTH (13*MAX_VFAT_ENTRIES+1)
@@ -673,11 +868,13 @@ public:
         if(a < b) return b;
         return a;
     }
+#ifndef INT32_IS_INT
     static inline int min(int a,int b)
     {
         if(a < b) return a;
         return b;
     }
+#endif
     static inline uint16_t min(uint16_t a,uint16_t b)
     {
         if(a < b) return a;
@@ -929,7 +1126,7 @@ void manage_inactivity(uint8_t debug);
 
 extern void finishNextSegment();
 #if NONLINEAR_SYSTEM
-extern uint8_t transformCartesianStepsToDeltaSteps(long cartesianPosSteps[], long deltaPosSteps[]);
+extern uint8_t transformCartesianStepsToDeltaSteps(int32_t cartesianPosSteps[], int32_t deltaPosSteps[]);
 #if SOFTWARE_LEVELING
 extern void calculatePlane(long factors[], long p1[], long p2[], long p3[]);
 extern float calcZOffset(long factors[], long pointX, long pointY);
@@ -953,8 +1150,10 @@ extern void motorCurrentControlInit();
 extern void microstepInit();
 
 #include "Printer.h"
+#include "InputShaper.h"
+#include "IsrLoad.h"
 #include "motion.h"
-extern long baudrate;
+extern int32_t baudrate;
 
 #include "HAL.h"
 
@@ -127,7 +127,7 @@ Custom M Codes
 - M204 - Set PID parameter X => Kp Y => Ki Z => Kd S<extruder> Default is current extruder. NUM_EXTRUDER=Heated bed
 - M205 - Output EEPROM settings
 - M206 - Set EEPROM value
-- M207 X<XY jerk> Z<Z Jerk> E<ExtruderJerk> - Changes current jerk values, but do not store them in eeprom.
+- M207 X<XY jerk> Z<Z Jerk> E<ExtruderJerk> J<junction deviation> - Changes current jerk values, but do not store them in eeprom.
 - M209 S<0/1> - Enable/disable auto retraction
 - M220 S<Feedrate multiplier in percent> - Increase/decrease given feedrate
 - M221 S<Extrusion flow multiplier in percent> - Increase/decrease given flow rate
@@ -174,6 +174,8 @@ Custom M Codes
 - M604 X<slowdownSteps> Y<errorSteps> Z<slowdownTo> T<extruderId> - Set jam detection values on a per extruder basis. If not set it uses defaults from Configuration.h
 - M666 - force communication error, required DEBUG_COM_ERRORS
 - M668 - set line number 0 without notice to simulate error
+- M409 S<1> - Report run time and cpu load of the stepper, pwm and extruder interrupts. S1 resets the statistics. Needs ISR_LOAD_STATISTICS.
+- M593 X Y F<frequency> D<damping> S<type> - Set input shaper frequency and damping for X and/or Y, type 0 = ZV, 1 = ZVD, 2 = MZV. F0 disables shaping.
 - M670 S<version> - Set eeprom version to a value for testing eeprom upgrade path.
 - M908 P<address> S<value> : Set stepper current for digipot (RAMBO board)
 - M999 - Continue from fatal error. M999 S1 will create a fatal error for testing.
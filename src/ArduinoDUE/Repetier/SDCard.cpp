@@ -214,6 +214,9 @@ void SDCard::stopPrint()
     #if NEW_COMMUNICATION
     GCodeSource::removeSource(&sdSource);
     #endif
+#if GCODE_MOVE_RING_SIZE > 0
+    GCodeMoveRing::reset();
+#endif
 	if(EVENT_SD_STOP_START) {
 		GCode::executeFString(PSTR(SD_RUN_ON_STOP));
 		if(SD_STOP_HEATER_AND_MOTORS_ON_STOP) {
@@ -228,167 +231,8 @@ void SDCard::writeCommand(GCode *code)
 {
     unsigned int sum1 = 0, sum2 = 0; // for fletcher-16 checksum
     uint8_t buf[100];
-    uint8_t p = 2;
     file.writeError = false;
-    uint16_t params = 128 | (code->params & ~1);
-	memcopy2(buf,&params);
-    //*(int*)buf = params;
-    if(code->isV2())   // Read G,M as 16 bit value
-    {
-		memcopy2(&buf[p],&code->params2);
-        //*(int*)&buf[p] = code->params2;
-        p += 2;
-        if(code->hasString())
-            buf[p++] = strlen(code->text);
-        if(code->hasM())
-        {
-			memcopy2(&buf[p],&code->M);
-            //*(int*)&buf[p] = code->M;
-            p += 2;
-        }
-        if(code->hasG())
-        {
-			memcopy2(&buf[p],&code->G);
-            //*(int*)&buf[p]= code->G;
-            p += 2;
-        }
-    }
-    else
-    {
-        if(code->hasM())
-        {
-            buf[p++] = (uint8_t)code->M;
-        }
-        if(code->hasG())
-        {
-            buf[p++] = (uint8_t)code->G;
-        }
-    }
-    if(code->hasX())
-    {
-		memcopy4(&buf[p],&code->X);
-        //*(float*)&buf[p] = code->X;
-        p += 4;
-    }
-    if(code->hasY())
-    {
-		memcopy4(&buf[p],&code->Y);
-        //*(float*)&buf[p] = code->Y;
-        p += 4;
-    }
-    if(code->hasZ())
-    {
-		memcopy4(&buf[p],&code->Z);
-        //*(float*)&buf[p] = code->Z;
-        p += 4;
-    }
-    if(code->hasE())
-    {
-		memcopy4(&buf[p],&code->E);
-        //*(float*)&buf[p] = code->E;
-        p += 4;
-    }
-    if(code->hasF())
-    {
-		memcopy4(&buf[p],&code->F);
-        //*(float*)&buf[p] = code->F;
-        p += 4;
-    }
-    if(code->hasT())
-    {
-        buf[p++] = code->T;
-    }
-    if(code->hasS())
-    {
-		memcopy4(&buf[p],&code->S);
-        //*(int32_t*)&buf[p] = code->S;
-        p += 4;
-    }
-    if(code->hasP())
-    {
-		memcopy4(&buf[p],&code->P);
-        //*(int32_t*)&buf[p] = code->P;
-        p += 4;
-    }
-    if(code->hasI())
-    {
-		memcopy4(&buf[p],&code->I);
-        //*(float*)&buf[p] = code->I;
-        p += 4;
-    }
-    if(code->hasJ())
-    {
-		memcopy4(&buf[p],&code->J);
-        //*(float*)&buf[p] = code->J;
-        p += 4;
-    }
-    if(code->hasR())
-    {
-		memcopy4(&buf[p],&code->R);
-        //*(float*)&buf[p] = code->R;
-        p += 4;
-    }
-    if(code->hasD())
-    {
-		memcopy4(&buf[p],&code->D);
-        //*(float*)&buf[p] = code->D;
-        p += 4;
-    }
-    if(code->hasC())
-    {
-		memcopy4(&buf[p],&code->C);
-        //*(float*)&buf[p] = code->C;
-        p += 4;
-    }
-    if(code->hasH())
-    {
-		memcopy4(&buf[p],&code->H);
-        //*(float*)&buf[p] = code->H;
-        p += 4;
-    }
-    if(code->hasA())
-    {
-		memcopy4(&buf[p],&code->A);
-        //*(float*)&buf[p] = code->A;
-        p += 4;
-    }
-    if(code->hasB())
-    {
-		memcopy4(&buf[p],&code->B);
-        //*(float*)&buf[p] = code->B;
-        p += 4;
-    }
-    if(code->hasK())
-    {
-		memcopy4(&buf[p],&code->K);
-        //*(float*)&buf[p] = code->K;
-        p += 4;
-    }
-    if(code->hasL())
-    {
-		memcopy4(&buf[p],&code->L);
-        //*(float*)&buf[p] = code->L;
-        p += 4;
-    }
-    if(code->hasO())
-    {
-		memcopy4(&buf[p],&code->O);
-        //*(float*)&buf[p] = code->O;
-        p += 4;
-    }
-    if(code->hasString())   // read 16 uint8_t into string
-    {
-        char *sp = code->text;
-        if(code->isV2())
-        {
-            uint8_t i = strlen(code->text);
-            for(; i; i--) buf[p++] = *sp++;
-        }
-        else
-        {
-            for(uint8_t i = 0; i < 16; ++i) buf[p++] = *sp++;
-        }
-    }
+    uint8_t p = code->packBinary(buf);
     uint8_t *ptr = buf;
     uint8_t len = p;
     while (len)
@@ -411,7 +255,7 @@ void SDCard::writeCommand(GCode *code)
 	for(int i=0;i<p;i++)
 	Com::printF(PSTR(" "),(int)buf[i]);
 	Com::println();*/
-    if(params == 128)
+    if((code->params & ~1) == 0)
     {
         Com::printErrorFLN(Com::tAPIDFinished);
     }
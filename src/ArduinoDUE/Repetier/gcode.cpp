@@ -42,6 +42,10 @@ uint8_t  GCode::formatErrors = 0;
 PGM_P GCode::fatalErrorMsg = NULL; ///< message unset = no fatal error 
 millis_t GCode::lastBusySignal = 0; ///< When was the last busy signal
 uint32_t GCode::keepAliveInterval = KEEP_ALIVE_INTERVAL;
+#if FEATURE_BINARY_V3
+uint8_t  GCode::batchPosition = 0;
+uint8_t  GCode::batchEnd = 0;
+#endif
 #if NEW_COMMUNICATION == 0
 int8_t   GCode::waitingForResend = -1; ///< Waiting for line to be resend. -1 = no wait.
 uint32_t GCode::lastLineNumber = 0; ///< Last line number received.
@@ -107,11 +111,18 @@ Second word if V2:
 - K : Bit 8 : 32-Bit float
 - L : Bit 9 : 32-Bit float
 - O : Bit 0 : 32-Bit float
+
+With Ext set the command is a version 3 move batch. The third byte holds the
+length of the move records, which follow the 16 bit line number.
 */
 uint8_t GCode::computeBinarySize(char *ptr)  // unsigned int bitfield) {
 {
     uint8_t s = 4; // include checksum and bitfield
     uint16_t bitfield = *(uint16_t*)ptr;
+#if FEATURE_BINARY_V3
+    if(bitfield & 8192) // bitfield, length, line number, records, checksum
+        return RMath::min(MAX_CMD_SIZE, (uint8_t)ptr[2] + 7);
+#endif
     if(bitfield & 1) s += 2;
     if(bitfield & 8) s += 4;
     if(bitfield & 16) s += 4;
@@ -176,6 +187,9 @@ void GCode::keepAlive(enum FirmwareState state) {
 
 void GCode::requestResend()
 {
+#if NEW_COMMUNICATION
+    GCodeSource::flushOutput(true);
+#endif
     HAL::serialFlush();
     commandsReceivingWritePosition = 0;
 #if NEW_COMMUNICATION
@@ -185,6 +199,13 @@ void GCode::requestResend()
     GCodeSource::activeSource->waitingForResend = 14;
     Com::println();
     Com::printFLN(Com::tResend,GCodeSource::activeSource->lastLineNumber + 1);
+#if ACK_WINDOW
+    if(GCodeSource::activeSource->ackWindow)
+    {
+        acknowledgeWindow(); // all lines before the resend line are received
+        return;
+    }
+#endif
 #else    
     if(sendAsBinary)
     waitingForResend = 30;
@@ -196,6 +217,18 @@ void GCode::requestResend()
     Com::printFLN(Com::tOk);
 }
 
+#if ACK_WINDOW && NEW_COMMUNICATION
+/** Acknowledges all lines up to the last received line of the active source with
+ok <line> P<free planner lines> B<free command buffers>. */
+void GCode::acknowledgeWindow()
+{
+    GCodeSource::activeSource->unacknowledged = 0;
+    Com::printF(Com::tOkSpace, GCodeSource::activeSource->lastLineNumber);
+    Com::printF(PSTR(" P"), (int)(PrintLine::getCacheSize() - PrintLine::getLinesCount()));
+    Com::printFLN(PSTR(" B"), (int)(GCODE_BUFFER_SIZE - bufferLength));
+}
+#endif
+
 /**
   Check if result is plausible. If it is, an ok is send and the command is stored in queue.
   If not, a resend and ok is send.
@@ -208,6 +241,12 @@ void GCode::checkAndPushCommand()
         {
 #if NEW_COMMUNICATION            
             GCodeSource::activeSource->lastLineNumber = actLineNumber;
+#if ACK_WINDOW
+            GCodeSource::activeSource->ackWindow = hasS() ? constrain(S, 0, ACK_WINDOW) : 0;
+            if(GCodeSource::activeSource->ackWindow)
+                acknowledgeWindow();
+            else
+#endif
             Com::printFLN(Com::tOk);
             GCodeSource::activeSource->waitingForResend = -1;
 #else
@@ -255,6 +294,9 @@ void GCode::checkAndPushCommand()
             {
                 // we have seen that line already. So we assume it is a repeated resend and we ignore it
                 commandsReceivingWritePosition = 0;
+#if ACK_WINDOW && NEW_COMMUNICATION
+                if(GCodeSource::activeSource->ackWindow) return; // acknowledged already
+#endif
                 Com::printFLN(Com::tSkip,actLineNumber);
                 Com::printFLN(Com::tOk);
             }
@@ -283,6 +325,9 @@ void GCode::checkAndPushCommand()
                 --waitingForResend;
 #endif
                 commandsReceivingWritePosition = 0;
+#if ACK_WINDOW && NEW_COMMUNICATION
+                if(GCodeSource::activeSource->ackWindow) return; // host sends everything again after the resend
+#endif
                 Com::printFLN(Com::tSkip, actLineNumber);
                 Com::printFLN(Com::tOk);
             }
@@ -306,12 +351,30 @@ void GCode::checkAndPushCommand()
 	if(GCode::hasFatalError() && !(hasM() && M==999)) {
 		GCode::reportFatalError();
 	} else {
+#if REALTIME_COMMANDS
+        if(isRealtimeCommand()) { // execute now instead of waiting for the commands before
+            bool lastWTA = Com::writeToAll;
+            echoCommand();
+            Commands::executeGCode(this);
+            Com::writeToAll = lastWTA; // the ok only goes to the source of the command
+        } else
+#endif
 		pushCommand();
 	}
 #ifdef DEBUG_COM_ERRORS
     if(hasM() && M == 667)
         return; // omit ok
 #endif
+#if ACK_WINDOW && NEW_COMMUNICATION
+    if(GCodeSource::activeSource->ackWindow && hasN())
+    {
+        // Acknowledge after half the window or when the host waits for it
+        if(++GCodeSource::activeSource->unacknowledged >= (GCodeSource::activeSource->ackWindow + 1) / 2 ||
+                !GCodeSource::activeSource->dataAvailable())
+            acknowledgeWindow();
+    }
+    else
+#endif
 #if ACK_WITH_LINENUMBER
     Com::printFLN(Com::tOkSpace, actLineNumber);
 #else
@@ -328,6 +391,29 @@ void GCode::checkAndPushCommand()
 #endif    
 }
 
+#if REALTIME_COMMANDS
+/** Commands that do not depend on the commands and moves before them. They are executed
+when they are received from a host connection, so status requests and overrides do not wait
+until all buffered commands are processed. Sd card and flash scripts can not correct errors
+interactively, which marks them as files: there the commands keep their place between the moves.
+M112 is handled even earlier, before the line number is checked. */
+bool GCode::isRealtimeCommand()
+{
+    if(!hasM() || hasG() || source->closeOnError()) return false;
+    switch(M)
+    {
+    case 105: // report temperatures
+    case 220: // feedrate multiplier
+    case 221: // flow multiplier
+#if FEATURE_BABYSTEPPING
+    case 290: // babysteps
+#endif
+        return true;
+    }
+    return false;
+}
+#endif
+
 void GCode::pushCommand()
 {
 #if !ECHO_ON_EXECUTE
@@ -381,6 +467,79 @@ void GCode::debugCommandBuffer()
     }
 }
 
+#if GCODE_MOVE_RING_SIZE > 0
+uint8_t GCodeMoveRing::buffer[GCODE_MOVE_RING_SIZE];
+uint16_t GCodeMoveRing::readPos = 0;
+uint16_t GCodeMoveRing::writePos = 0;
+uint16_t GCodeMoveRing::endPos = GCODE_MOVE_RING_SIZE;
+uint16_t GCodeMoveRing::length = 0;
+
+#if NEW_COMMUNICATION
+#define GCODE_MOVE_SOURCE sizeof(GCodeSource *)
+#else
+#define GCODE_MOVE_SOURCE 0
+#endif
+#define GCODE_MOVE_HEADER (GCODE_MOVE_SOURCE + 1) // source and absolutePosition before the binary command
+
+/** Stores com if it is a G0/G1 move and the ring has room. Returns true if stored. */
+bool GCodeMoveRing::add(GCode *com) {
+    if(!com->hasG() || com->G > 1 || (com->params & GCODE_MOVE_NO_PARAMS) != 0)
+        return false;
+#if SDSUPPORT
+    if(sd.savetosd)
+        return false;
+#endif
+    uint8_t record[100];
+    uint16_t size = com->packBinary(record) + GCODE_MOVE_HEADER;
+    if(length == 0)
+        readPos = writePos = 0;
+    if(endPos == GCODE_MOVE_RING_SIZE) { // records are between readPos and writePos
+        if(writePos + size > GCODE_MOVE_RING_SIZE) {
+            if(size > readPos) return false;
+            endPos = writePos;
+            writePos = 0;
+        }
+    } else if(writePos + size > readPos) return false;
+#if NEW_COMMUNICATION
+    memcpy(&buffer[writePos], &com->source, GCODE_MOVE_SOURCE);
+#endif
+    buffer[writePos + GCODE_MOVE_SOURCE] = com->absolutePosition;
+    memcpy(&buffer[writePos + GCODE_MOVE_HEADER], record, size - GCODE_MOVE_HEADER);
+    writePos += size;
+    length++;
+    return true;
+}
+
+/** Sends stored moves to the planner. Without all only while the planner has free lines,
+so the caller does not block. */
+void GCodeMoveRing::flush(bool all) {
+    while(length && (all || PrintLine::getLinesCount() < PrintLine::getCacheSize())) {
+        uint8_t *record = &buffer[readPos];
+        GCode code;
+        code.unpackBinary(record + GCODE_MOVE_HEADER);
+        code.text = NULL;
+        code.internalCommand = false;
+        code.absolutePosition = record[GCODE_MOVE_SOURCE] != 0;
+#if NEW_COMMUNICATION
+        memcpy(&code.source, record, GCODE_MOVE_SOURCE);
+#endif
+        readPos += GCODE_MOVE_HEADER + GCode::computeBinarySize((char *)record + GCODE_MOVE_HEADER) - 2; // no checksum stored
+        if(readPos == endPos) {
+            readPos = 0;
+            endPos = GCODE_MOVE_RING_SIZE;
+        }
+        length--;
+        Commands::executeGCode(&code);
+    }
+}
+
+/** Drops all stored moves. Used when a print gets stopped or the printer killed. */
+void GCodeMoveRing::reset() {
+    readPos = writePos = length = 0;
+    endPos = GCODE_MOVE_RING_SIZE;
+}
+#endif
+
 /** \brief Execute commands in progmem stored string. Multiple commands are separated by \n 
 Used to execute memory stored parts called from gcodes. For new commands use the
 flash sender instead.
@@ -391,6 +550,9 @@ void GCode::executeFString(FSTRINGPARAM(cmd))
     uint8_t buflen;
     char c = 0;
     GCode code;
+#if GCODE_MOVE_RING_SIZE > 0
+    GCodeMoveRing::flush(true); // keep order with already acknowledged moves
+#endif
     do
     {
         // Wait for a free place in command buffer
@@ -448,6 +610,14 @@ void GCode::readFromSerial()
 #if NEW_COMMUNICATION
     bool lastWTA = Com::writeToAll;
     Com::writeToAll = false;
+#if FEATURE_BINARY_V3
+    if(batchEnd)   // moves of a version 3 batch are waiting
+    {
+        nextBinaryMove();
+        Com::writeToAll = lastWTA;
+        return;
+    }
+#endif
     if(!GCodeSource::activeSource->dataAvailable())
     {
         if(GCodeSource::activeSource->closeOnError()) { // this device does not support resends so all errors are final and we always expect there is a new char!
@@ -475,6 +645,8 @@ void GCode::readFromSerial()
         if(commandsReceivingWritePosition == 0) // nothing read, we can rotate to next input source
             GCodeSource::rotateSource();
     }
+    else if(commandsReceivingWritePosition == 0 && !GCodeSource::activeSource->commandAvailable())
+        GCodeSource::rotateSource(); // do not start a line other sources would have to wait for
     while(GCodeSource::activeSource->dataAvailable() && commandsReceivingWritePosition < MAX_CMD_SIZE)    // consume data until no data or buffer full
     {
         GCodeSource::activeSource->timeOfLastDataPacket = time; //HAL::timeInMilliseconds();
@@ -499,6 +671,23 @@ void GCode::readFromSerial()
                 return;
             }
             sendAsBinary = (commandReceiving[0] & 128) != 0;
+            if(!sendAsBinary && commandReceiving[0] != '\n' && commandReceiving[0] != '\r' && commandReceiving[0] != ';')
+            {
+                uint8_t n = GCodeSource::activeSource->readLine(commandReceiving + 1, MAX_CMD_SIZE - 1);
+                if(n)   // complete line was buffered, strip comment like the byte wise loop does
+                {
+                    commandsReceivingWritePosition += n;
+                    uint8_t *comment = (uint8_t *)memchr(commandReceiving, ';', commandsReceivingWritePosition);
+                    if(comment != NULL)
+                    {
+                        uint8_t last = commandReceiving[commandsReceivingWritePosition - 1];
+                        commandsReceivingWritePosition = comment - commandReceiving + 1;
+                        if(last == 0 || last == '\n' || last == '\r')
+                            *comment = last; // line end follows the command
+                        // else ';' is last character and starts comment skipping below
+                    }
+                }
+            }
         } // first byte detection
         if(sendAsBinary)
         {
@@ -507,6 +696,14 @@ void GCode::readFromSerial()
             binaryCommandSize = computeBinarySize((char*)commandReceiving);
             if(commandsReceivingWritePosition == binaryCommandSize)
             {
+#if FEATURE_BINARY_V3
+                if(commandReceiving[1] & 32)   // Ext bit, version 3 move batch
+                {
+                    startBinaryBatch();
+                    Com::writeToAll = lastWTA;
+                    return;
+                }
+#endif
                 GCode *act = &commandsBuffered[bufferWriteIndex];
                 act->source = GCodeSource::activeSource; // we need to know where to write answers to
                 if(act->parseBinary(commandReceiving, true)) {  // Success
@@ -570,6 +767,10 @@ void GCode::readFromSerial()
             }            
          }
        } // while
+#if ACK_WINDOW
+       if(GCodeSource::activeSource->unacknowledged && commandsReceivingWritePosition == 0 && !GCodeSource::activeSource->dataAvailable())
+           acknowledgeWindow(); // host sends no more lines, so it waits for this ok
+#endif
        Com::writeToAll = lastWTA;
 #else    
     if(!HAL::serialByteAvailable())
@@ -749,6 +950,150 @@ void GCode::readFromSerial()
 #endif
 }
 
+/** Packs the command into binary protocol layout and returns its size in bytes. */
+uint8_t GCode::packBinary(uint8_t *buf)
+{
+    uint8_t p = 2;
+    uint16_t bits = 128 | (params & ~1);
+	memcopy2(buf,&bits);
+    if(isV2())   // Write G,M as 16 bit value
+    {
+		memcopy2(&buf[p],&params2);
+        p += 2;
+        if(hasString())
+            buf[p++] = strlen(text);
+        if(hasM())
+        {
+			memcopy2(&buf[p],&M);
+            p += 2;
+        }
+        if(hasG())
+        {
+			memcopy2(&buf[p],&G);
+            p += 2;
+        }
+    }
+    else
+    {
+        if(hasM())
+        {
+            buf[p++] = (uint8_t)M;
+        }
+        if(hasG())
+        {
+            buf[p++] = (uint8_t)G;
+        }
+    }
+    if(hasX())
+    {
+		memcopy4(&buf[p],&X);
+        p += 4;
+    }
+    if(hasY())
+    {
+		memcopy4(&buf[p],&Y);
+        p += 4;
+    }
+    if(hasZ())
+    {
+		memcopy4(&buf[p],&Z);
+        p += 4;
+    }
+    if(hasE())
+    {
+		memcopy4(&buf[p],&E);
+        p += 4;
+    }
+    if(hasF())
+    {
+		memcopy4(&buf[p],&F);
+        p += 4;
+    }
+    if(hasT())
+    {
+        buf[p++] = T;
+    }
+    if(hasS())
+    {
+		memcopy4(&buf[p],&S);
+        p += 4;
+    }
+    if(hasP())
+    {
+		memcopy4(&buf[p],&P);
+        p += 4;
+    }
+    if(hasI())
+    {
+		memcopy4(&buf[p],&I);
+        p += 4;
+    }
+    if(hasJ())
+    {
+		memcopy4(&buf[p],&J);
+        p += 4;
+    }
+    if(hasR())
+    {
+		memcopy4(&buf[p],&R);
+        p += 4;
+    }
+    if(hasD())
+    {
+		memcopy4(&buf[p],&D);
+        p += 4;
+    }
+    if(hasC())
+    {
+		memcopy4(&buf[p],&C);
+        p += 4;
+    }
+    if(hasH())
+    {
+		memcopy4(&buf[p],&H);
+        p += 4;
+    }
+    if(hasA())
+    {
+		memcopy4(&buf[p],&A);
+        p += 4;
+    }
+    if(hasB())
+    {
+		memcopy4(&buf[p],&B);
+        p += 4;
+    }
+    if(hasK())
+    {
+		memcopy4(&buf[p],&K);
+        p += 4;
+    }
+    if(hasL())
+    {
+		memcopy4(&buf[p],&L);
+        p += 4;
+    }
+    if(hasO())
+    {
+		memcopy4(&buf[p],&O);
+        p += 4;
+    }
+    if(hasString())   // write text, 16 uint8_t in V1
+    {
+        char *sp = text;
+        if(isV2())
+        {
+            uint8_t i = strlen(text);
+            for(; i; i--) buf[p++] = *sp++;
+        }
+        else
+        {
+            for(uint8_t i = 0; i < 16; ++i) buf[p++] = *sp++;
+        }
+    }
+    return p;
+}
+
 /**
   Converts a binary uint8_tfield containing one GCode line into a GCode structure.
   Returns true if checksum was correct.
@@ -756,11 +1101,22 @@ void GCode::readFromSerial()
 bool GCode::parseBinary(uint8_t *buffer,bool fromSerial)
 {
     internalCommand = !fromSerial;
+    absolutePosition = false;
+    if(!checkBinaryChecksum(buffer, binaryCommandSize))
+        return false;
+    unpackBinary(buffer);
+    formatErrors = 0;
+    return true;
+}
+
+/** Tests the fletcher-16 checksum in the last 2 of size bytes. */
+bool GCode::checkBinaryChecksum(uint8_t *buffer, uint8_t size)
+{
     unsigned int sum1 = 0, sum2 = 0; // for fletcher-16 checksum
     // first do fletcher-16 checksum tests see
     // http://en.wikipedia.org/wiki/Fletcher's_checksum
     uint8_t *p = buffer;
-    uint8_t len = binaryCommandSize - 2;
+    uint8_t len = size - 2;
     while (len)
     {
         uint8_t tlen = len > 21 ? 21 : len;
@@ -784,7 +1140,12 @@ bool GCode::parseBinary(uint8_t *buffer,bool fromSerial)
         }
         return false;
     }
-    p = buffer;
+    return true;
+}
+
+void GCode::unpackBinary(uint8_t *buffer)
+{
+    uint8_t *p = buffer;
     params = *(uint16_t *)p;
     p += 2;
     uint8_t textlen = 16;
@@ -926,8 +1287,183 @@ bool GCode::parseBinary(uint8_t *buffer,bool fromSerial)
         text[textlen] = 0; // Terminate string overwriting checksum
         waitUntilAllCommandsAreParsed = true; // Don't destroy string until executed
     }
-    formatErrors = 0;
-    return true;
+}
+
+#if FEATURE_BINARY_V3
+/** Reads a zigzag encoded varint of a version 3 move record. */
+static int32_t readBinaryVarint(uint8_t *&p)
+{
+    uint32_t v = 0;
+    uint8_t shift = 0, b;
+    do
+    {
+        b = *p++;
+        v |= static_cast<uint32_t>(b & 127) << shift;
+        shift += 7;
+    }
+    while(b & 128);
+    return static_cast<int32_t>(v >> 1) ^ -static_cast<int32_t>(v & 1);
+}
+
+/** Tests that the records between p and end are complete version 3 move records. */
+static bool validBinaryBatch(uint8_t *p, uint8_t *end)
+{
+    if(p >= end) return false; // at least one move
+    while(p < end)
+    {
+        uint8_t header = *p++;
+        if(header & 128) return false;
+        for(fast8_t axis = 0; axis < 4; axis++)
+        {
+            if((header & (1 << axis)) == 0) continue;
+            for(fast8_t i = 0;; i++)
+            {
+                if(p >= end || i == 5) return false;
+                if((*p++ & 128) == 0) break;
+            }
+        }
+        if(header & 16) p += 4;
+    }
+    return p == end;
+}
+
+/** Called when a complete version 3 batch is in commandReceiving. The moves are
+pushed one by one, the first one tests the line number and sends the ok. */
+void GCode::startBinaryBatch()
+{
+    uint8_t end = 5 + commandReceiving[2];
+    if(!checkBinaryChecksum(commandReceiving, binaryCommandSize) || end + 2 != binaryCommandSize ||
+            !validBinaryBatch(&commandReceiving[5], &commandReceiving[end]))
+    {
+        if(GCodeSource::activeSource->closeOnError()) // this device does not support resends so all errors are final!
+            GCodeSource::activeSource->close();
+        else
+            requestResend();
+        GCodeSource::rotateSource();
+        return;
+    }
+    batchPosition = 5;
+    batchEnd = end;
+    nextBinaryMove();
+}
+
+/** Converts the next record of the pending batch into a G0/G1 command. */
+void GCode::nextBinaryMove()
+{
+    GCodeSource *src = GCodeSource::activeSource; // sources do not rotate while a batch is pending
+    bool first = batchPosition == 5;
+    uint8_t *p = &commandReceiving[batchPosition];
+    uint8_t header = *p++;
+    GCode *act = &commandsBuffered[bufferWriteIndex];
+    float *value[4] = {&act->X, &act->Y, &act->Z, &act->E};
+    int32_t position[4];
+    act->source = src;
+    act->params = 128 | 4 | ((header & 15) << 3) | (header & 16 ? 256 : 0);
+    act->params2 = 0;
+    act->G = (header & 32) ? 0 : 1;
+    act->text = NULL;
+    act->internalCommand = false;
+    act->absolutePosition = true;
+    for(fast8_t axis = 0; axis < 4; axis++)
+    {
+        position[axis] = src->binaryPosition[axis];
+        if((header & (1 << axis)) == 0) continue;
+        int32_t v = readBinaryVarint(p);
+        int32_t delta = (header & 64) ? v - position[axis] : v; // absolute or delta to last move
+        position[axis] += delta;
+        *value[axis] = static_cast<float>(position[axis]) / (axis == E_AXIS ? BINARY_V3_E_UNITS : BINARY_V3_XYZ_UNITS);
+    }
+    if(header & 16)
+    {
+        memcopy4(&act->F, p);
+        p += 4;
+    }
+    batchPosition = p - commandReceiving;
+    if(batchPosition >= batchEnd)
+        batchEnd = 0;
+    if(first)
+    {
+        act->params |= 1;
+        actLineNumber = act->N = *(uint16_t *)&commandReceiving[3];
+        uint8_t oldLength = bufferLength;
+        act->checkAndPushCommand();
+        if(bufferLength == oldLength)   // skipped, resend or fatal error, drop the batch
+        {
+            batchEnd = 0;
+            GCodeSource::rotateSource();
+            return;
+        }
+    }
+    else
+        pushCommand();
+    memcpy(src->binaryPosition, position, sizeof(position));
+    if(batchEnd == 0)
+        GCodeSource::rotateSource();
+}
+#endif
+
+// Exact powers of ten for parseFloatValue
+static const double parsePowers[10] = {1.0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9};
+
+float GCode::parseFloatValue(char *s)
+{
+    while(*s == 32) s++; // skip spaces
+    char *start = s;
+    bool negative = (*s == '-');
+    if(negative || *s == '+') s++;
+    uint32_t mantissa = 0;
+    uint8_t digits = 0, decimals = 0;
+    bool hasDigits = false, hasDot = false;
+    for(;; s++)
+    {
+        char c = *s;
+        if(c >= '0' && c <= '9')
+        {
+            hasDigits = true;
+            if((mantissa != 0 || c != '0') && ++digits > 9) break;
+            mantissa = mantissa * 10 + (c - '0');
+            if(hasDot) decimals++;
+        }
+        else if(c == '.' && !hasDot)
+            hasDot = true;
+        else break;
+    }
+    char c = *s;
+    if(!hasDigits || digits > 9 || decimals > 9 || c == 'e' || c == 'E' || c == 'x' || c == 'X')
+    {
+        char *endPtr;
+        float f = strtod(start, &endPtr);
+        if(start == endPtr) f = 0.0; // treat empty string "x " as "x0"
+        return f;
+    }
+    float f;
+    // Mantissa and power are exact floats, so one division rounds like strtod does.
+    // Above 6 decimals float rounding of the double result could differ, use double then.
+    if(mantissa < 16777216UL && decimals <= 6)
+        f = (float)mantissa / (float)parsePowers[decimals];
+    else
+        f = (float)((double)mantissa / parsePowers[decimals]);
+    return negative ? -f : f;
+}
+
+long GCode::parseLongValue(char *s)
+{
+    while(*s == 32) s++; // skip spaces
+    char *start = s;
+    bool negative = (*s == '-');
+    if(negative || *s == '+') s++;
+    uint32_t value = 0;
+    uint8_t digits = 0;
+    while(*s >= '0' && *s <= '9')
+    {
+        if(++digits > 9) // may overflow, let strtol handle it
+        {
+            char *endPtr;
+            return strtol(start, &endPtr, 10);
+        }
+        value = value * 10 + (*s++ - '0');
+    }
+    return negative ? -(long)value : (long)value; // treat empty string argument "p " as "p0"
 }
 
 /**
@@ -939,6 +1475,7 @@ bool GCode::parseAscii(char *line,bool fromSerial)
     params = 0;
     params2 = 0;
     internalCommand = !fromSerial;
+    absolutePosition = false;
 	bool hasChecksum = false;
     char c;
     while ( (c = *(pos++)) )
@@ -1323,6 +1860,9 @@ SerialGCodeSource serial0Source(&RFSERIAL);
 #if BLUETOOTH_SERIAL > 0
 SerialGCodeSource serial1Source(&RFSERIAL2);
 #endif
+#if SERIAL_USB_SOURCE
+USBGCodeSource usbSource;
+#endif
 #endif
 
 #if BLUETOOTH_SERIAL > 0
@@ -1337,17 +1877,23 @@ GCodeSource *GCodeSource::sources[MAX_DATA_SOURCES] = {&serial0Source};
 GCodeSource *GCodeSource::writeableSources[MAX_DATA_SOURCES] = {&serial0Source};
 #endif    
 GCodeSource *GCodeSource::activeSource = &serial0Source;
+uint8_t GCodeSource::outputBuffer[OUTPUT_BUFFER_SIZE];
+uint8_t GCodeSource::outputLength = 0;
+GCodeSource *GCodeSource::outputTarget = NULL;
 
-void GCodeSource::registerSource(GCodeSource *newSource) {
+bool GCodeSource::registerSource(GCodeSource *newSource) {
   for(fast8_t i = 0; i < numSources; i++) { // skip register if already contained
       if(sources[i] == newSource) {
-          return;
+          return true;
       }
   }      
+  if(numSources >= MAX_DATA_SOURCES)
+      return false;
   //printAllFLN(PSTR("AddSource:"),numSources);
   sources[numSources++] = newSource;
   if(newSource->supportsWrite())
      writeableSources[numWriteSources++] = newSource;  
+  return true;
 }
 
 void GCodeSource::removeSource(GCodeSource *delSource) {
@@ -1369,42 +1915,85 @@ void GCodeSource::removeSource(GCodeSource *delSource) {
     rotateSource();
 }
 
+/** Selects the source the next command is read from. The source with highest priority
+that has a complete command wins, sources with equal priority take turns as the search starts
+behind the active source. If no command is complete, the first source with data is started
+as before. Pointers are kept instead of indices, as dataAvailable may close and remove a source. */
 void GCodeSource::rotateSource() { ///< Move active to next source
-    fast8_t bestIdx = 0; //,oldIdx = 0;
+    fast8_t idx = 0;
     fast8_t i;
     for(i = 0; i < numSources; i++) {
         if(sources[i] == activeSource) {
-           //oldIdx = 
-           bestIdx = i;
+           idx = i;
            break;
        }
     }    
+    GCodeSource *best = NULL, *partial = NULL;
     for(i = 0; i < numSources; i++) {
-        if(++bestIdx >= numSources)
-            bestIdx = 0;
-        if(sources[bestIdx]->dataAvailable()) break;
-    }
-    //if(oldIdx != bestIdx)
-    //    printAllFLN(PSTR("Rotate:"),(int32_t)bestIdx);
-    activeSource = sources[bestIdx];
+        if(++idx >= numSources)
+            idx = 0; // active source is tested last
+        GCodeSource *s = sources[idx];
+        if(best != NULL && s->priority <= best->priority)
+            continue;
+        if(s->commandAvailable())
+            best = s;
+        else if(partial == NULL && s->dataAvailable())
+            partial = s;
+    }
+    //printAllFLN(PSTR("Rotate:"),(int32_t)idx);
+    if(best == NULL)
+        best = (partial != NULL ? partial : activeSource);
+    activeSource = best;
     GCode::commandsReceivingWritePosition = 0;
 }   
  
 void GCodeSource::writeToAll(uint8_t byte) { ///< Write to all listening sources 
 #if NEW_COMMUNICATION
-    if(Com::writeToAll) {
-        fast8_t i;
-        for(i = 0; i < numWriteSources; i++) {
-            writeableSources[i]->writeByte(byte);
-        }
-    } else {
-        activeSource->writeByte(byte);
-    }
+    GCodeSource *target = (Com::writeToAll ? NULL : activeSource);
+    if(target != outputTarget) {
+        flushOutput(true);
+        outputTarget = target;
+    }
+    outputBuffer[outputLength++] = byte;
+    if(byte == '\n' || outputLength == OUTPUT_BUFFER_SIZE)
+        flushOutput(outputLength == OUTPUT_BUFFER_SIZE);
 #else    
     HAL::serialWriteByte(byte);
 #endif       
 }
 
+/** Sends the collected output to its sources. Without wait only the part all of them
+can take without waiting is sent, the rest stays buffered until the next call from
+Commands::checkForPeriodicalActions. The buffer can be larger than the transmit
+buffer of a port, so a long line leaves in several parts. */
+void GCodeSource::flushOutput(bool wait) {
+#if NEW_COMMUNICATION
+    if(outputLength == 0)
+        return;
+    fast8_t i;
+    int length = outputLength, space;
+    if(!wait) {
+        if(outputTarget != NULL) {
+            if((space = outputTarget->writeSpace()) < length)
+                length = space;
+        } else
+            for(i = 0; i < numWriteSources; i++)
+                if((space = writeableSources[i]->writeSpace()) < length)
+                    length = space;
+        if(length <= 0)
+            return;
+    }
+    if(outputTarget != NULL)
+        outputTarget->writeBytes(outputBuffer, length);
+    else
+        for(i = 0; i < numWriteSources; i++)
+            writeableSources[i]->writeBytes(outputBuffer, length);
+    outputLength -= length;
+    if(outputLength)
+        memmove(outputBuffer, outputBuffer + length, outputLength);
+#endif
+}
+
 void GCodeSource::printAllFLN(FSTRINGPARAM(text) ) {
     bool old = Com::writeToAll;
     Com::writeToAll = true;
@@ -1423,6 +2012,14 @@ GCodeSource::GCodeSource() {
     lastLineNumber = 0;
     wasLastCommandReceivedAsBinary = false;
     waitingForResend = -1;
+    priority = SOURCE_PRIORITY_HOST;
+#if ACK_WINDOW
+    ackWindow = 0;
+    unacknowledged = 0;
+#endif
+#if FEATURE_BINARY_V3
+    memset(binaryPosition, 0, sizeof(binaryPosition));
+#endif
 }
 
 // ----- serial connection source -----
@@ -1442,17 +2039,129 @@ bool SerialGCodeSource::closeOnError() { // return true if the channel can not i
 bool SerialGCodeSource::dataAvailable() { // would read return a new byte?
     return stream->available();
 }    
+/** Binary commands and the zeros after a binary resend have no line end. They are
+started with the first byte like before. */
+bool SerialGCodeSource::commandAvailable() {
+#if SERIAL_LINE_BUFFER
+    if(stream == &RFSERIAL) { // only the main port counts line ends while receiving
+        int c = RFSERIAL.peek();
+        return c >= 0 && (c == 0 || (c & 128) || RFSERIAL.lineAvailable());
+    }
+#endif
+    return dataAvailable();
+}
 int SerialGCodeSource::readByte() {
     return stream->read();
 }
+#if SERIAL_LINE_BUFFER
+uint8_t SerialGCodeSource::readLine(uint8_t *buffer, uint8_t maxLength) {
+    if(stream != &RFSERIAL) // only the main port detects line ends while receiving
+        return 0;
+    return RFSERIAL.readLine(buffer, maxLength);
+}
+#endif
 void SerialGCodeSource::writeByte(uint8_t byte) {
     stream->write(byte);
 }
+void SerialGCodeSource::writeBytes(const uint8_t *data, uint8_t length) {
+    stream->write(data, length);
+}
+int SerialGCodeSource::writeSpace() {
+#if SERIAL_WRITE_SPACE
+    if(stream == &RFSERIAL)
+        return RFSERIAL.outputUnused() - 1; // one place in the ring stays free
+#endif
+    return 255;
+}
 void SerialGCodeSource::close() {
 }    
+
+// ----- native USB source -----
+
+#if SERIAL_USB_SOURCE
+#define USB_RING_MASK (SERIAL_USB_BUFFER_SIZE - 1)
+
+USBGCodeSource::USBGCodeSource() {
+    readPos = writePos = 0;
+    linesReceived = linesRead = 0;
+}
+/** Moves all bytes the USB driver has received into the ring. If the ring is full the
+driver keeps the rest and the host has to wait, so nothing gets lost. */
+void USBGCodeSource::receive() {
+    int n = SerialUSB.available();
+    while(n-- > 0) {
+        uint16_t next = (writePos + 1) & USB_RING_MASK;
+        if(next == readPos) break;
+        uint8_t c = SerialUSB.read();
+        ring[writePos] = c;
+        writePos = next;
+        if(c == '\n' || c == '\r') linesReceived++;
+    }
+}
+bool USBGCodeSource::isOpen() {
+    return true;
+}
+bool USBGCodeSource::supportsWrite() { ///< true if write is a non dummy function
+    return true;
+}
+bool USBGCodeSource::closeOnError() { // return true if the channel can not interactively correct errors.
+    return false;
+}
+bool USBGCodeSource::dataAvailable() { // would read return a new byte?
+    if(readPos == writePos)
+        receive();
+    return readPos != writePos;
+}
+bool USBGCodeSource::commandAvailable() {
+    if(linesReceived == linesRead)
+        receive();
+    if(readPos == writePos)
+        return false;
+    uint8_t c = ring[readPos];
+    return c == 0 || (c & 128) || linesReceived != linesRead; // binary commands have no line end
+}
+int USBGCodeSource::readByte() {
+    if(readPos == writePos)
+        return -1;
+    uint8_t c = ring[readPos];
+    readPos = (readPos + 1) & USB_RING_MASK;
+    if(c == '\n' || c == '\r') linesRead++;
+    return c;
+}
+uint8_t USBGCodeSource::readLine(uint8_t *buffer, uint8_t maxLength) {
+    if(linesReceived == linesRead) {
+        receive();
+        if(linesReceived == linesRead)
+            return 0;
+    }
+    uint8_t n = 0;
+    while(n < maxLength && readPos != writePos) {
+        uint8_t c = ring[readPos];
+        readPos = (readPos + 1) & USB_RING_MASK;
+        buffer[n++] = c;
+        if(c == '\n' || c == '\r') {
+            linesRead++;
+            break;
+        }
+        if(c == 0) break;
+    }
+    return n;
+}
+void USBGCodeSource::writeByte(uint8_t byte) {
+    SerialUSB.write(byte);
+}
+void USBGCodeSource::writeBytes(const uint8_t *data, uint8_t length) {
+    SerialUSB.write(data, length); // one packet instead of one per byte
+}
+void USBGCodeSource::close() {
+}
+#endif
 // ----- SD card source -----
 
 #if SDSUPPORT
+SDCardGCodeSource::SDCardGCodeSource():GCodeSource() {
+    priority = SOURCE_PRIORITY_FILE; // host commands go first, the file is always ready
+}
 bool SDCardGCodeSource::isOpen() {
     return (sd.sdmode > 0 && sd.sdmode < 100);
 }
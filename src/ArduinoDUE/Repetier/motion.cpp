@@ -62,12 +62,15 @@
 #if PRINTLINE_CACHE_SIZE < 4
 #error PRINTLINE_CACHE_SIZE must be at least 5
 #endif
+#if DYNAMIC_PRINTLINE_CACHE && (PRINTLINE_CACHE_SIZE_MAX < PRINTLINE_CACHE_SIZE || PRINTLINE_CACHE_SIZE_MAX > 255)
+#error PRINTLINE_CACHE_SIZE_MAX must be between PRINTLINE_CACHE_SIZE and 255
+#endif
 
 //Inactivity shutdown variables
 millis_t previousMillisCmd = 0;
 millis_t maxInactiveTime = MAX_INACTIVE_TIME * 1000L;
 millis_t stepperInactiveTime = STEPPER_INACTIVE_TIME * 1000L;
-long baudrate = BAUDRATE;         ///< Communication speed rate.
+int32_t baudrate = BAUDRATE;        ///< Communication speed rate.
 #if USE_ADVANCE
 #if ENABLE_QUADRATIC_ADVANCE
 int maxadv = 0;
@@ -78,7 +81,14 @@ float maxadvspeed = 0;
 uint8_t pwm_pos[NUM_PWM]; // 0-NUM_EXTRUDER = Heater 0-NUM_EXTRUDER of extruder, NUM_EXTRUDER = Heated bed, NUM_EXTRUDER+1 Board fan, NUM_EXTRUDER+2 = Fan
 volatile int waitRelax = 0; // Delay filament relax at the end of print, could be a simple timeout
 
+#if DYNAMIC_PRINTLINE_CACHE
+PrintLine *PrintLine::lines = NULL;               ///< Cache for print moves, allocated by allocateCache.
+ufast8_t PrintLine::cacheSize = 0;                ///< Number of entries in lines.
+ufast8_t PrintLine::moveCacheLow = MOVE_CACHE_LOW;
+int32_t PrintLine::lowTicksPerMove = LOW_TICKS_PER_MOVE;
+#else
 PrintLine PrintLine::lines[PRINTLINE_CACHE_SIZE]; ///< Cache for print moves.
+#endif
 PrintLine *PrintLine::cur = NULL;               ///< Current printing line
 #if CPU_ARCH == ARCH_ARM
 volatile bool PrintLine::nlFlag = false;
@@ -86,6 +96,14 @@ volatile bool PrintLine::nlFlag = false;
 ufast8_t PrintLine::linesWritePos = 0;            ///< Position where we write the next cached line move.
 volatile ufast8_t PrintLine::linesCount = 0;      ///< Number of lines cached 0 = nothing to do.
 ufast8_t PrintLine::linesPos = 0;                 ///< Position for executing line movement.
+#if JUNCTION_DEVIATION
+PrintLine *PrintLine::arcLast = NULL;
+float PrintLine::arcLength[JUNCTION_ARC_SEGMENTS];
+float PrintLine::arcTurn[JUNCTION_ARC_SEGMENTS];
+ufast8_t PrintLine::arcPos = 0;
+ufast8_t PrintLine::arcCount = 0;
+int8_t PrintLine::arcTurnSign = 0;
+#endif
 
 /**
 Move printer the given number of steps. Puts the move into the queue. Used by e.g. homing commands.
@@ -258,8 +276,8 @@ void PrintLine::queueCartesianSegmentTo(uint8_t check_endstops, uint8_t pathOpti
 #if ENABLE_BACKLASH_COMPENSATION
     if((p->isXYZMove()) && ((p->dir & XYZ_DIRPOS) ^ (Printer::backlashDir & XYZ_DIRPOS)) & (Printer::backlashDir >> 3)) { // We need to compensate backlash, add a move
         PrintLine::waitForXFreeLines(2);
-        uint8_t wpos2 = PrintLine::linesWritePos + 1;
-        if(wpos2 >= PRINTLINE_CACHE_SIZE) wpos2 = 0;
+        ufast8_t wpos2 = PrintLine::linesWritePos;
+        PrintLine::nextPlannerIndex(wpos2);
         PrintLine *p2 = &PrintLine::lines[wpos2];
         memcpy(p2, p, sizeof(PrintLine)); // Move current data to p2
         uint8_t changed = (p->dir & XYZ_DIRPOS) ^ (Printer::backlashDir & XYZ_DIRPOS);
@@ -403,6 +421,15 @@ void PrintLine::queueCartesianMove(uint8_t check_endstops, uint8_t pathOptimize)
         if(p->delta[axis]) p->setMoveOfAxis(axis);
         Printer::currentPositionSteps[axis] = Printer::destinationSteps[axis];
     }
+#if ARC_NATIVE
+    if(nativeArc.requested) {
+        nativeArc.requested = false;
+        if(p->initNativeArc(axisDistanceMM)) {
+            p->calculateMove(axisDistanceMM, pathOptimize, X_AXIS);
+            return;
+        }
+    }
+#endif
     if(p->isNoMove()) {
         if(newPath)   // need to delete dummy elements, otherwise commands can get locked.
             resetPathPlanner();
@@ -412,8 +439,8 @@ void PrintLine::queueCartesianMove(uint8_t check_endstops, uint8_t pathOptimize)
 #if ENABLE_BACKLASH_COMPENSATION
     if((p->isXYZMove()) && ((p->dir & XYZ_DIRPOS) ^ (Printer::backlashDir & XYZ_DIRPOS)) & (Printer::backlashDir >> 3)) { // We need to compensate backlash, add a move
         waitForXFreeLines(2);
-        uint8_t wpos2 = linesWritePos + 1;
-        if(wpos2 >= PRINTLINE_CACHE_SIZE) wpos2 = 0;
+        ufast8_t wpos2 = linesWritePos;
+        nextPlannerIndex(wpos2);
         PrintLine *p2 = &lines[wpos2];
         memcpy(p2, p, sizeof(PrintLine)); // Move current data to p2
         uint8_t changed = (p->dir & XYZ_DIRPOS) ^ (Printer::backlashDir & XYZ_DIRPOS);
@@ -473,10 +500,10 @@ void PrintLine::calculateMove(float axisDistanceMM[], uint8_t pathOptimize, fast
     //float timeForMove = (float)(F_CPU)*distance / (isXOrYMove() ? RMath::max(Printer::minimumSpeed, Printer::feedrate) : Printer::feedrate); // time is in ticks
     float timeForMove = (float)(F_CPU) * distance / Printer::feedrate; // time is in ticks
     //bool critical = Printer::isZProbingActive();
-    if(linesCount < MOVE_CACHE_LOW && timeForMove < LOW_TICKS_PER_MOVE) { // Limit speed to keep cache full.
+    if(linesCount < getMoveCacheLow() && timeForMove < getLowTicksPerMove()) { // Limit speed to keep cache full.
         //Com::printF(PSTR("L:"),(int)linesCount);
         //Com::printF(PSTR(" Old "),timeForMove);
-        timeForMove += (3 * (LOW_TICKS_PER_MOVE - timeForMove)) / (linesCount + 1); // Increase time if queue gets empty. Add more time if queue gets smaller.
+        timeForMove += (3 * (getLowTicksPerMove() - timeForMove)) / (linesCount + 1); // Increase time if queue gets empty. Add more time if queue gets smaller.
         //Com::printFLN(PSTR("Slow "),timeForMove);
         //critical = true;
     }
@@ -508,6 +535,10 @@ void PrintLine::calculateMove(float axisDistanceMM[], uint8_t pathOptimize, fast
         axisInterval[E_AXIS] = axisDistanceMM[E_AXIS] * toTicks / Printer::maxFeedrate[E_AXIS];
         limitInterval = RMath::max(axisInterval[E_AXIS], limitInterval);
     } else axisInterval[E_AXIS] = 0;
+#if ARC_NATIVE
+    if(isArcMove())
+        limitInterval = RMath::max(static_cast<int32_t>(axisDistanceMM[X_AXIS] * toTicks / nativeArc.maxSpeed), limitInterval);
+#endif
 #if DRIVE_SYSTEM == DELTA
     if(axisDistanceMM[VIRTUAL_AXIS] >= 0) {// only for deltas all speeds in all directions have same limit
         axisInterval[VIRTUAL_AXIS] = axisDistanceMM[VIRTUAL_AXIS] * toTicks / (Printer::maxFeedrate[Z_AXIS]);
@@ -544,6 +575,11 @@ void PrintLine::calculateMove(float axisDistanceMM[], uint8_t pathOptimize, fast
     axisInterval[VIRTUAL_AXIS] = limitInterval; //timeForMove/stepsRemaining;
 #endif
     fullSpeed = distance * inverseTimeS;
+#if ARC_NATIVE
+    float arcSpeed = fabs(speedX);
+    if(isArcMove()) // junction to the previous move uses the start tangent
+        setNativeArcSpeeds(nativeArc.start, arcSpeed);
+#endif
     //long interval = axis_interval[primary_axis]; // time for every step in ticks with full speed
     //If acceleration is enabled, do some Bresenham calculations depending on which axis will lead it.
 #if RAMP_ACCELERATION
@@ -574,6 +610,11 @@ void PrintLine::calculateMove(float axisDistanceMM[], uint8_t pathOptimize, fast
             // v = a * t => t = v/a = F_CPU/(c*a) => 1/t = c*a/F_CPU
             slowestAxisPlateauTimeRepro = RMath::min(slowestAxisPlateauTimeRepro, (float)axisInterval[i] * (float)accel[i]); //  steps/s^2 * step/tick  Ticks/s^2
     }
+#if S_CURVE_ACCELERATION
+    // The s-curve reaches 1.875 times the mean acceleration of the ramp in its middle.
+    // Plan with 1/1.875 of the limit, so the peak stays at the configured acceleration.
+    slowestAxisPlateauTimeRepro *= 1.0f / 1.875f;
+#endif
 
     // Errors for delta move are initialized in timer (except extruder)
 #if !NONLINEAR_SYSTEM
@@ -584,14 +625,25 @@ void PrintLine::calculateMove(float axisDistanceMM[], uint8_t pathOptimize, fast
 #endif
     invFullSpeed = 1.0 / fullSpeed;
     accelerationPrim = slowestAxisPlateauTimeRepro / axisInterval[primaryAxis]; // a = v/t = F_CPU/(c*t): Steps/s^2
+#if ARC_NATIVE
+    if(isArcMove()) // steps of the primary axis are rotation iterations
+        accelerationPrim = slowestAxisPlateauTimeRepro * stepsRemaining / timeForMove;
+#endif
     //Now we can calculate the new primary axis acceleration, so that the slowest axis max acceleration is not violated
     fAcceleration = 262144.0 * (float)accelerationPrim / F_CPU; // will overflow without float!
-    accelerationDistance2 = 2.0 * distance * slowestAxisPlateauTimeRepro * fullSpeed / ((float)F_CPU); // mm^2/s^2
-    startSpeed = endSpeed = minSpeed = safeSpeed(drivingAxis);
-    if(startSpeed > Printer::feedrate)
-        startSpeed = endSpeed = minSpeed = Printer::feedrate;
+    float accelerationDistance2Float = 2.0 * distance * slowestAxisPlateauTimeRepro * fullSpeed / ((float)F_CPU); // mm^2/s^2
+    float safe = safeSpeed(drivingAxis);
+    if(safe > Printer::feedrate)
+        safe = Printer::feedrate;
+    startSpeed = endSpeed = minSpeed = toPlannerSpeed(safe);
+#if FIXED_POINT_PLANNER
+    plannerFullSpeed = toPlannerSpeed(fullSpeed);
+    accelerationDistance2 = static_cast<planner_speed2_t>(RMath::min(accelerationDistance2Float * (PLANNER_SPEED_SCALE * PLANNER_SPEED_SCALE), 4294967040.0f));
+#else
+    accelerationDistance2 = accelerationDistance2Float;
+#endif
     // Can accelerate to full speed within the line
-    if (startSpeed * startSpeed + accelerationDistance2 >= fullSpeed * fullSpeed)
+    if (safe * safe + accelerationDistance2Float >= fullSpeed * fullSpeed)
         setNominalMove();
 
     vMax = F_CPU / fullInterval; // maximum steps per second, we can reach
@@ -653,6 +705,10 @@ void PrintLine::calculateMove(float axisDistanceMM[], uint8_t pathOptimize, fast
 #endif
     // Make result permanent
     if (pathOptimize) waitRelax = 70;
+#if ARC_NATIVE
+    if(isArcMove())
+        finishNativeArc(arcSpeed);
+#endif
     pushLine();
     DEBUG_MEMORY;
 }
@@ -672,6 +728,7 @@ void PrintLine::updateTrapezoids() {
     PrintLine *firstLine;
     PrintLine *act = &lines[linesWritePos];
     InterruptProtectedBlock noInts;
+    EVENT_PLANNER_UPDATE_START;
 
     // First we find out how far back we could go with optimization.
 
@@ -681,7 +738,9 @@ void PrintLine::updateTrapezoids() {
     // Now ignore enough segments to gain enough time for path planning
     millis_t timeleft = 0;
     // Skip as many stored moves as needed to gain enough time for computation
-#if PRINTLINE_CACHE_SIZE < 10
+#if DYNAMIC_PRINTLINE_CACHE
+#define minTime (cacheSize < 10 ? 4500L * cacheSize : 45000L)
+#elif PRINTLINE_CACHE_SIZE < 10
 #define minTime 4500L * PRINTLINE_CACHE_SIZE
 #else
 #define minTime 45000L
@@ -704,6 +763,7 @@ void PrintLine::updateTrapezoids() {
         act->setStartSpeedFixed(true);
         act->updateStepsParameter();
         act->unblock();
+        EVENT_PLANNER_UPDATE_END;
         return;
     }
     // now we have at least one additional move for optimization
@@ -734,12 +794,17 @@ void PrintLine::updateTrapezoids() {
         act->setStartSpeedFixed(true);
         act->updateStepsParameter();
         firstLine->unblock();
+        EVENT_PLANNER_UPDATE_END;
         return;
     } else {
         computeMaxJunctionSpeed(previous, act); // Set maximum junction speed if we have a real move before
     }
     // Increase speed if possible neglecting current speed
-    backwardPlanner(linesWritePos, first);
+    ufast8_t changed = backwardPlanner(linesWritePos, first);
+    if(changed != first) { // moves in front keep their speeds
+        firstLine->unblock();
+        first = changed;
+    }
     // Reduce speed to reachable speeds
     forwardPlanner(first);
 
@@ -747,9 +812,9 @@ void PrintLine::updateTrapezoids() {
     if(Printer::debugEcho()) {
         Com::printF(PSTR("Planner: "), (int)linesCount);
         previousPlannerIndex(first);
-        Com::printF(PSTR(" F "), lines[first].startSpeed, 1);
-        Com::printF(PSTR(" - "), lines[first].endSpeed, 1);
-        Com::printF(PSTR("("), lines[first].maxJunctionSpeed, 1);
+        Com::printF(PSTR(" F "), fromPlannerSpeed(lines[first].startSpeed), 1);
+        Com::printF(PSTR(" - "), fromPlannerSpeed(lines[first].endSpeed), 1);
+        Com::printF(PSTR("("), fromPlannerSpeed(lines[first].maxJunctionSpeed), 1);
         Com::printF(PSTR(","), (int)lines[first].joinFlags);
         nextPlannerIndex(first);
     }
@@ -759,9 +824,9 @@ void PrintLine::updateTrapezoids() {
         lines[first].updateStepsParameter();
 #ifdef DEBUG_PLANNER
         if(Printer::debugEcho()) {
-            Com::printF(PSTR(" / "), lines[first].startSpeed, 1);
-            Com::printF(PSTR(" - "), lines[first].endSpeed, 1);
-            Com::printF(PSTR("("), lines[first].maxJunctionSpeed, 1);
+            Com::printF(PSTR(" / "), fromPlannerSpeed(lines[first].startSpeed), 1);
+            Com::printF(PSTR(" - "), fromPlannerSpeed(lines[first].endSpeed), 1);
+            Com::printF(PSTR("("), fromPlannerSpeed(lines[first].maxJunctionSpeed), 1);
             Com::printF(PSTR(","), (int)lines[first].joinFlags);
 #ifdef DEBUG_QUEUE_MOVE
             Com::println();
@@ -776,11 +841,12 @@ void PrintLine::updateTrapezoids() {
     } while(first != linesWritePos);
     act->updateStepsParameter();
     act->unblock();
+    EVENT_PLANNER_UPDATE_END;
 #ifdef DEBUG_PLANNER
     if(Printer::debugEcho()) {
-        Com::printF(PSTR(" / "), lines[first].startSpeed, 1);
-        Com::printF(PSTR(" - "), lines[first].endSpeed, 1);
-        Com::printF(PSTR("("), lines[first].maxJunctionSpeed, 1);
+        Com::printF(PSTR(" / "), fromPlannerSpeed(lines[first].startSpeed), 1);
+        Com::printF(PSTR(" - "), fromPlannerSpeed(lines[first].endSpeed), 1);
+        Com::printF(PSTR("("), fromPlannerSpeed(lines[first].maxJunctionSpeed), 1);
         Com::printFLN(PSTR(","), (int)lines[first].joinFlags);
     }
 #endif
@@ -842,12 +908,17 @@ inline void PrintLine::computeMaxJunctionSpeed(PrintLine *previous, PrintLine *c
     // move -> move (with or without extrusion)
     // First we compute the normalized jerk for speed 1
     float factor = 1.0;
+    float maxJoinSpeed = RMath::min(current->fullSpeed, previous->fullSpeed);
+#if JUNCTION_DEVIATION
+    float junctionSpeed = junctionDeviationSpeed(previous, current);
+    if(junctionSpeed < maxJoinSpeed) // never below the start speed jerk allows
+        factor = RMath::max(junctionSpeed, RMath::min(maxJoinSpeed, Printer::maxJerk * 0.5f)) / maxJoinSpeed;
+#else
     float lengthFactor = 1.0;
 #ifdef REDUCE_ON_SMALL_SEGMENTS
     if(previous->distance < MAX_JERK_DISTANCE)
         lengthFactor = static_cast<float>(MAX_JERK_DISTANCE * MAX_JERK_DISTANCE) / (previous->distance * previous->distance);
 #endif
-    float maxJoinSpeed = RMath::min(current->fullSpeed, previous->fullSpeed);
 #if (DRIVE_SYSTEM == DELTA) // No point computing Z Jerk separately for delta moves
 #ifdef ALTERNATIVE_JERK
     float jerk = maxJoinSpeed * lengthFactor * (1.0 - (current->speedX * previous->speedX + current->speedY * previous->speedY + current->speedZ * previous->speedZ) / (current->fullSpeed * previous->fullSpeed));
@@ -871,6 +942,7 @@ inline void PrintLine::computeMaxJunctionSpeed(PrintLine *previous, PrintLine *c
         if(factor * maxJoinSpeed * 2.0 < Printer::maxJerk)
             factor = Printer::maxJerk / (2.0 * maxJoinSpeed);
     }
+#endif // JUNCTION_DEVIATION
 #if DRIVE_SYSTEM != DELTA
     if((previous->dir | current->dir) & ZSTEP) {
         float dz = fabs(current->speedZ - previous->speedZ);
@@ -882,23 +954,83 @@ inline void PrintLine::computeMaxJunctionSpeed(PrintLine *previous, PrintLine *c
     if(eJerk > Extruder::current->maxStartFeedrate)
         factor = RMath::min(factor, Extruder::current->maxStartFeedrate / eJerk);
 
-    previous->maxJunctionSpeed = maxJoinSpeed * factor; // set speed limit
+    previous->maxJunctionSpeed = toPlannerSpeed(maxJoinSpeed * factor); // set speed limit
 #ifdef DEBUG_QUEUE_MOVE
     if(Printer::debugEcho()) {
         Com::printF(PSTR("ID:"), (int)previous);
-        Com::printFLN(PSTR(" MJ:"), previous->maxJunctionSpeed);
+        Com::printFLN(PSTR(" MJ:"), fromPlannerSpeed(previous->maxJunctionSpeed));
     }
 #endif // DEBUG_QUEUE_MOVE
 }
 
+#if JUNCTION_DEVIATION
+/** Junction speed of the centripetal cornering model.
+
+The corner is driven on the circle that touches both segments and stays
+Printer::junctionDeviation mm away from the junction point, with the centripetal
+acceleration v^2/r limited to the acceleration of the segments.
+
+Curves exported as many short segments get a tiny circle at every facet
+that way, so the last JUNCTION_ARC_SEGMENTS junctions turning in the same
+direction are also treated as facets of one arc with radius
+sum(length)/sum(turn angle). A junction is a facet if the arc through the
+segment ends deviates less than JUNCTION_ARC_TOLERANCE from the segments.
+The faster of both speeds is used.
+*/
+float PrintLine::junctionDeviationSpeed(PrintLine *previous, PrintLine *current) {
+    float maxJoinSpeed = RMath::min(current->fullSpeed, previous->fullSpeed);
+    float dot = current->speedX * previous->speedX + current->speedY * previous->speedY + current->speedZ * previous->speedZ;
+    float norm2 = (current->speedX * current->speedX + current->speedY * current->speedY + current->speedZ * current->speedZ) *
+                  (previous->speedX * previous->speedX + previous->speedY * previous->speedY + previous->speedZ * previous->speedZ);
+    if(norm2 <= 0) { // Pure extrusion, only extruder jerk applies
+        arcCount = arcPos = 0;
+        return maxJoinSpeed;
+    }
+    float cosTurn = RMath::min(1.0f, RMath::max(-1.0f, dot / static_cast<float>(sqrt(norm2))));
+    float sinHalf = sqrt(0.5f * (1.0f + cosTurn)); // sin of half the angle between the segments
+    float acceleration = RMath::min(previous->accelerationDistance2 / previous->distance,
+                                    current->accelerationDistance2 / current->distance) * (0.5f / (PLANNER_SPEED_SCALE * PLANNER_SPEED_SCALE)); // mm/s^2
+    float speed2 = sinHalf < 0.9999f ? acceleration * Printer::junctionDeviation * sinHalf / (1.0f - sinHalf) : maxJoinSpeed * maxJoinSpeed;
+
+    // Collect facets of a curve
+    float turn = acos(cosTurn);
+    float length = 0.5f * (previous->distance + current->distance);
+    float cross = previous->speedX * current->speedY - previous->speedY * current->speedX;
+    int8_t sign = (cross > 0 ? 1 : (cross < 0 ? -1 : 0));
+    if(previous != arcLast || sign * arcTurnSign < 0)
+        arcCount = arcPos = 0;
+    arcLast = current;
+    if(turn * length > 8.0f * JUNCTION_ARC_TOLERANCE) { // real corner, L^2/(8r) with r = L/turn
+        arcCount = arcPos = 0;
+        return sqrt(speed2);
+    }
+    if(sign) arcTurnSign = sign;
+    arcLength[arcPos] = length;
+    arcTurn[arcPos] = turn;
+    if(++arcPos == JUNCTION_ARC_SEGMENTS) arcPos = 0;
+    if(arcCount < JUNCTION_ARC_SEGMENTS) arcCount++;
+    if(arcCount > 1) {
+        float lengthSum = 0, turnSum = 0;
+        for(ufast8_t i = 0; i < arcCount; i++) {
+            lengthSum += arcLength[i];
+            turnSum += arcTurn[i];
+        }
+        if(turnSum * maxJoinSpeed * maxJoinSpeed <= acceleration * lengthSum) // arc radius allows full speed
+            return maxJoinSpeed;
+        speed2 = RMath::max(speed2, acceleration * lengthSum / turnSum);
+    }
+    return sqrt(speed2);
+}
+#endif // JUNCTION_DEVIATION
+
 /** Update parameter used by updateTrapezoids
 
 Computes the acceleration/deceleration steps and advanced parameter associated.
 */
 void PrintLine::updateStepsParameter() {
     if(areParameterUpToDate() || isWarmUp()) return;
-    float startFactor = startSpeed * invFullSpeed;
-    float endFactor   = endSpeed   * invFullSpeed;
+    float startFactor = fromPlannerSpeed(startSpeed) * invFullSpeed;
+    float endFactor   = fromPlannerSpeed(endSpeed)   * invFullSpeed;
     vStart = vMax * startFactor; //starting speed
     vEnd   = vMax * endFactor;
 
@@ -923,6 +1055,27 @@ void PrintLine::updateStepsParameter() {
         accelSteps = accelSteps - RMath::min(static_cast<int32_t>(accelSteps), static_cast<int32_t>(red));
         decelSteps = decelSteps - RMath::min(static_cast<int32_t>(decelSteps), static_cast<int32_t>(red));
     }
+#if S_CURVE_ACCELERATION
+    // The s-curve ramp takes the same time and distance as the trapezoid ramp it replaces,
+    // so only the peak speed and ramp durations are needed. Durations use the truncated
+    // fAcceleration like HAL::ComputeV in the stepper interrupt.
+    vPeak = vMax;
+#if CPU_ARCH == ARCH_AVR
+    uint32_t peak2 = HAL::U16SquaredToU32(vStart) + (accelerationPrim << 1) * accelSteps;
+#else
+    uint64_t peak2 = static_cast<uint64_t>(vStart) * static_cast<uint64_t>(vStart) + static_cast<uint64_t>(accelerationPrim << 1) * accelSteps;
+#endif
+    if(peak2 < vmax2)
+#if CPU_ARCH == ARCH_AVR
+        vPeak = HAL::integerSqrt(peak2);
+#else
+        vPeak = HAL::integer64Sqrt(peak2);
+#endif
+    if(vPeak < vStart) vPeak = vStart;
+    float ticksPerSpeed = 262144.0f / static_cast<float>(fAcceleration ? fAcceleration : 1);
+    sCurveRamp(static_cast<float>(vPeak - vStart) * ticksPerSpeed, accelTime, accelShift, accelInv);
+    sCurveRamp(static_cast<float>(vPeak > vEnd ? vPeak - vEnd : 0) * ticksPerSpeed, decelTime, decelShift, decelInv);
+#endif
     setParameterUpToDate();
 #ifdef DEBUG_QUEUE_MOVE
     if(Printer::debugEcho()) {
@@ -932,24 +1085,45 @@ void PrintLine::updateStepsParameter() {
         Com::printF(Com::tDBAccelSteps, (long)accelSteps);
         Com::printF(Com::tSlash, (long)decelSteps);
         Com::printFLN(Com::tSlash, (long)stepsRemaining);
-        Com::printF(Com::tDBGStartEndSpeed, startSpeed, 1);
-        Com::printFLN(Com::tSlash, endSpeed, 1);
+        Com::printF(Com::tDBGStartEndSpeed, fromPlannerSpeed(startSpeed), 1);
+        Com::printFLN(Com::tSlash, fromPlannerSpeed(endSpeed), 1);
         Com::printFLN(Com::tDBGFlags, (uint32_t)flags);
         Com::printFLN(Com::tDBGJoinFlags, (uint32_t)joinFlags);
     }
 #endif
 }
 
+#if S_CURVE_ACCELERATION
+/** Stores a ramp duration so the stepper interrupt can map the elapsed ticks
+to 0..65535 with a shift and one 32 bit multiplication. */
+void PrintLine::sCurveRamp(float ticks, uint16_t &time, uint8_t &shift, uint32_t &inv) {
+    uint32_t t = (ticks > 4e9f ? 4000000000UL : static_cast<uint32_t>(ticks));
+    shift = 0;
+    while(t > 65535) {
+        t >>= 1;
+        shift++;
+    }
+    if(t == 0) t = 1;
+    time = t;
+    inv = 0xffffffffUL / t;
+}
+#endif
+
 /**
 Compute the maximum speed from the last entered move.
 The backwards planner traverses the moves from last to first looking at deceleration. The RHS of the accelerate/decelerate ramp.
 
 start = last line inserted
 last = last element until we check
+
+Returns the first move forward planning has to start with. With INCREMENTAL_PLANNER the
+planner stops at the first junction that does not get faster by more than
+INCREMENTAL_PLANNER_TOLERANCE. All moves in front got planned with nearly the same speed
+already, so they are kept and updated with one of the next moves instead.
 */
-inline void PrintLine::backwardPlanner(ufast8_t start, ufast8_t last) {
+inline ufast8_t PrintLine::backwardPlanner(ufast8_t start, ufast8_t last) {
     PrintLine *act = &lines[start], *previous;
-    float lastJunctionSpeed = act->endSpeed; // Start always with safe speed
+    planner_speed_t lastJunctionSpeed = act->endSpeed; // Start always with safe speed
 
     //PREVIOUS_PLANNER_INDEX(last); // Last element is already fixed in start speed
     while(start != last) {
@@ -973,7 +1147,17 @@ inline void PrintLine::backwardPlanner(ufast8_t start, ufast8_t last) {
          }*/
 
         // Avoid speed calculations if we know we can accelerate within the line
-        lastJunctionSpeed = (act->isNominalMove() ? act->fullSpeed : sqrt(lastJunctionSpeed * lastJunctionSpeed + act->accelerationDistance2)); // acceleration is acceleration*distance*2! What can be reached if we try?
+        lastJunctionSpeed = (act->isNominalMove() ? act->getPlannerFullSpeed() : reachableSpeed(lastJunctionSpeed, act->accelerationDistance2)); // acceleration is acceleration*distance*2! What can be reached if we try?
+#if INCREMENTAL_PLANNER
+        if(act != &lines[linesWritePos]) { // new move has no valid start speed yet
+            planner_speed_t newEndSpeed = RMath::max(previous->minSpeed, RMath::min(lastJunctionSpeed, previous->maxJunctionSpeed));
+            if(newEndSpeed >= previous->endSpeed && newEndSpeed <= previous->endSpeed * (1.0 + INCREMENTAL_PLANNER_TOLERANCE)) {
+                previous->unblock();
+                nextPlannerIndex(start);
+                return start;
+            }
+        }
+#endif
         // If that speed is more that the maximum junction speed allowed then ...
         if(lastJunctionSpeed >= previous->maxJunctionSpeed) { // Limit is reached
             // If the previous line's end speed has not been updated to maximum speed then do it now
@@ -996,13 +1180,14 @@ inline void PrintLine::backwardPlanner(ufast8_t start, ufast8_t last) {
         }
         act = previous;
     } // while loop
+    return last;
 }
 
 void PrintLine::forwardPlanner(ufast8_t first) {
     PrintLine *act;
     PrintLine *next = &lines[first];
-    float vmaxRight;
-    float leftSpeed = next->startSpeed;
+    planner_speed_t vmaxRight;
+    planner_speed_t leftSpeed = next->startSpeed;
     while(first != linesWritePos) { // All except last segment, which has fixed end speed
         act = next;
         nextPlannerIndex(first);
@@ -1024,11 +1209,11 @@ void PrintLine::forwardPlanner(ufast8_t first) {
                 }*/
 #endif
         // Avoid speed calculates if we know we can accelerate within the line.
-        vmaxRight = (act->isNominalMove() ? act->fullSpeed : sqrt(leftSpeed * leftSpeed + act->accelerationDistance2));
+        vmaxRight = (act->isNominalMove() ? act->getPlannerFullSpeed() : reachableSpeed(leftSpeed, act->accelerationDistance2));
         if(vmaxRight > act->endSpeed) { // Could be higher next run?
             if(leftSpeed < act->minSpeed) {
                 leftSpeed = act->minSpeed;
-                act->endSpeed = sqrt(leftSpeed * leftSpeed + act->accelerationDistance2);
+                act->endSpeed = reachableSpeed(leftSpeed, act->accelerationDistance2);
             }
             act->startSpeed = leftSpeed;
             next->startSpeed = leftSpeed = RMath::max(RMath::min(act->endSpeed, act->maxJunctionSpeed), next->minSpeed);
@@ -1042,7 +1227,7 @@ void PrintLine::forwardPlanner(ufast8_t first) {
             act->invalidateParameter();
             if(act->minSpeed > leftSpeed) {
                 leftSpeed = act->minSpeed;
-                vmaxRight = sqrt(leftSpeed * leftSpeed + act->accelerationDistance2);
+                vmaxRight = reachableSpeed(leftSpeed, act->accelerationDistance2);
             }
             act->startSpeed = leftSpeed;
             act->endSpeed = RMath::max(act->minSpeed, vmaxRight);
@@ -1142,7 +1327,7 @@ void PrintLine::logLine() {
     Com::printFLN(Com::tDBGFlags, (uint32_t)flags);
     Com::printFLN(Com::tDBGFullSpeed, fullSpeed);
     Com::printFLN(Com::tDBGVMax, (int32_t)vMax);
-    Com::printFLN(Com::tDBGAcceleration, accelerationDistance2);
+    Com::printFLN(Com::tDBGAcceleration, accelerationDistance2 * (1.0f / (PLANNER_SPEED_SCALE * PLANNER_SPEED_SCALE)));
     Com::printFLN(Com::tDBGAccelerationPrim, (int32_t)accelerationPrim);
     Com::printFLN(Com::tDBGRemainingSteps, stepsRemaining);
 #if USE_ADVANCE
@@ -1154,8 +1339,22 @@ void PrintLine::logLine() {
 #endif // DEBUG_QUEUE_MOVE
 }
 
+#if DYNAMIC_PRINTLINE_CACHE
+/** Allocates the move cache with the size stored in EEPROM. Only called from Printer::setup, so
+a new size gets active with the next reset. MOVE_CACHE_LOW and LOW_TICKS_PER_MOVE are meant for
+PRINTLINE_CACHE_SIZE moves and get scaled, so the low mark still buffers the same time. */
+void PrintLine::allocateCache() {
+    int16_t size = constrain(EEPROM::moveCacheSize(), 5, PRINTLINE_CACHE_SIZE_MAX);
+    while((lines = static_cast<PrintLine *>(calloc(size, sizeof(PrintLine)))) == NULL && size > 5)
+        size = RMath::max(static_cast<int16_t>(size >> 1), static_cast<int16_t>(5));
+    cacheSize = size;
+    moveCacheLow = MOVE_CACHE_LOW * size / PRINTLINE_CACHE_SIZE;
+    lowTicksPerMove = LOW_TICKS_PER_MOVE * PRINTLINE_CACHE_SIZE / size;
+}
+#endif
+
 void PrintLine::waitForXFreeLines(uint8_t b, bool allowMoves) {
-    while(getLinesCount() + b > PRINTLINE_CACHE_SIZE) { // wait for a free entry in movement cache
+    while(getLinesCount() + b > getCacheSize()) { // wait for a free entry in movement cache
         //GCode::readFromSerial();
         Commands::checkForPeriodicalActions(allowMoves);
     }
@@ -1637,7 +1836,7 @@ bool NonlinearSegment::checkEndstops(PrintLine *cur, bool checkall) {
     return r != 0;
 }
 
-void PrintLine::calculateDirectionAndDelta(int32_t difference[], ufast8_t *dir, int32_t delta[]) {
+void PrintLine::calculateDirectionAndDelta(int32_t difference[], uint8_t *dir, int32_t delta[]) {
     *dir = 0;
     //Find direction
     if(difference[X_AXIS] != 0) {
@@ -1897,7 +2096,7 @@ uint8_t PrintLine::queueNonlinearMove(uint8_t check_endstops, uint8_t pathOptimi
     }
 
     float cartesianDistance;
-    ufast8_t cartesianDir;
+    uint8_t cartesianDir;
     int32_t cartesianDeltaSteps[E_AXIS_ARRAY];
     calculateDirectionAndDelta(difference, &cartesianDir, cartesianDeltaSteps);
     if (!calculateDistance(axisDistanceMM, cartesianDir, &cartesianDistance)) {
@@ -1925,7 +2124,7 @@ uint8_t PrintLine::queueNonlinearMove(uint8_t check_endstops, uint8_t pathOptimi
         Com::printFLN(Com::tDBGDeltaSeconds, seconds);
 #endif
         float sps = static_cast<float>((cartesianDir & ESTEP) == ESTEP ? Printer::printMovesPerSecond : Printer::travelMovesPerSecond);
-        segmentCount = RMath::max(1, static_cast<int16_t>(sps * seconds));
+        segmentCount = RMath::max(static_cast<int16_t>(1), static_cast<int16_t>(sps * seconds));
 #ifdef DEBUG_SEGMENT_LENGTH
         float segDist = cartesianDistance / (float)segmentCount;
         if(segDist > Printer::maxRealSegmentLength) {
@@ -1966,7 +2165,7 @@ uint8_t PrintLine::queueNonlinearMove(uint8_t check_endstops, uint8_t pathOptimi
 
     // Insert dummy moves if necessary
     // Need to leave at least one slot open for the first split move
-    insertWaitMovesIfNeeded(pathOptimize, RMath::min(PRINTLINE_CACHE_SIZE - 4, numLines));
+    insertWaitMovesIfNeeded(pathOptimize, RMath::min(static_cast<int>(getCacheSize()) - 4, numLines));
     uint32_t oldEDestination = Printer::destinationSteps[E_AXIS]; // flow and volumetric extrusion changed virtual target
     Printer::currentPositionSteps[E_AXIS] = 0;
 
@@ -2091,6 +2290,10 @@ void PrintLine::arc(float *position, float *target, float *offset, float radius,
     if (millimeters_of_travel < 0.001f) {
         return;// treat as succes because there is nothing to do;
     }
+#if ARC_NATIVE
+    if(queueNativeArc(position, target, offset, radius, fabs(angular_travel), isclockwise))
+        return;
+#endif
     //uint16_t segments = (radius>=BIG_ARC_RADIUS ? floor(millimeters_of_travel/MM_PER_ARC_SEGMENT_BIG) : floor(millimeters_of_travel/MM_PER_ARC_SEGMENT));
     // Increase segment size if printing faster then computation speed allows
     uint16_t segments = (Printer::feedrate > 60.0f ? floor(millimeters_of_travel / RMath::min(static_cast<float>(MM_PER_ARC_SEGMENT_BIG), Printer::feedrate * 0.01666f * static_cast<float>(MM_PER_ARC_SEGMENT))) : floor(millimeters_of_travel / static_cast<float>(MM_PER_ARC_SEGMENT)));
@@ -2182,9 +2385,171 @@ void PrintLine::arc(float *position, float *target, float *offset, float radius,
     // Ensure last segment arrives at target location.
     Printer::moveToReal(target[X_AXIS], target[Y_AXIS], IGNORE_COORDINATE, target[E_AXIS], IGNORE_COORDINATE);
 }
+
+#if ARC_NATIVE
+NativeArc PrintLine::nativeArc;
+
+/** Queues the arc as one move. The stepper interrupt rotates the radius vector with
+shifts only (Minsky circle algorithm) and steps x and y when the rounded position changes,
+so the arc needs one queue entry and no trigonometry per segment.
+Returns false if the arc has to be split into lines, because x and y have different
+resolution, a correction would bend the circle or it would hit a software endstop. */
+bool PrintLine::queueNativeArc(float *position, float *target, float *offset, float radius, float angle, uint8_t isclockwise) {
+    float stepsPerMM = Printer::axisStepsPerMM[X_AXIS];
+    if(stepsPerMM != Printer::axisStepsPerMM[Y_AXIS])
+        return false;
+#if FEATURE_AXISCOMP
+    if(EEPROM::axisCompTanXY() != 0)
+        return false;
+#endif
+#if BED_CORRECTION_METHOD != 1 && FEATURE_AUTOLEVEL
+    if(Printer::isAutolevelActive())
+        return false;
 #endif
+#if DISTORTION_CORRECTION
+    if(Printer::distortion.isEnabled())
+        return false;
+#endif
+#if ENABLE_BACKLASH_COMPENSATION
+    if(Printer::backlashX != 0 || Printer::backlashY != 0)
+        return false;
+#endif
+    float radiusSteps = radius * stepsPerMM;
+    if(radiusSteps < 2 || radiusSteps > 60000)
+        return false;
+    // End must be on the circle, otherwise the last iterations would walk straight to it
+    float centerX = position[X_AXIS] + offset[X_AXIS], centerY = position[Y_AXIS] + offset[Y_AXIS];
+    if(fabs(hypot(target[X_AXIS] - centerX, target[Y_AXIS] - centerY) - radius) * stepsPerMM > 2)
+        return false;
+    // Each iteration steps e at most once
+    if(fabs(target[E_AXIS] * Printer::axisStepsPerMM[E_AXIS] - Printer::currentPositionSteps[E_AXIS]) * Printer::extrusionFactor > 0.5f * angle * radiusSteps)
+        return false;
+    float centerZ;
+    Printer::transformToPrinter(centerX + Printer::offsetX, centerY + Printer::offsetY, Printer::currentPosition[Z_AXIS] + Printer::offsetZ, centerX, centerY, centerZ);
+    centerX *= stepsPerMM;
+    centerY *= stepsPerMM;
+    if(!Printer::isNoDestinationCheck()) { // a circle can not be constrained like a line
+#if min_software_endstop_x
+        if(centerX - radiusSteps < Printer::xMinStepsAdj) return false;
+#endif
+#if min_software_endstop_y
+        if(centerY - radiusSteps < Printer::yMinStepsAdj) return false;
+#endif
+#if max_software_endstop_x
+        if(centerX + radiusSteps > Printer::xMaxStepsAdj) return false;
+#endif
+#if max_software_endstop_y
+        if(centerY + radiusSteps > Printer::yMaxStepsAdj) return false;
+#endif
+    }
+    float accel = RMath::min(RMath::min(Printer::maxAccelerationMMPerSquareSecond[X_AXIS], Printer::maxAccelerationMMPerSquareSecond[Y_AXIS]),
+                             RMath::min(Printer::maxTravelAccelerationMMPerSquareSecond[X_AXIS], Printer::maxTravelAccelerationMMPerSquareSecond[Y_AXIS]));
+    nativeArc.center[X_AXIS] = centerX;
+    nativeArc.center[Y_AXIS] = centerY;
+    nativeArc.angle = angle;
+    nativeArc.clockwise = isclockwise;
+    nativeArc.maxSpeed = sqrt(accel * radius); // centripetal acceleration v^2/r
+    nativeArc.requested = true;
+    Printer::moveToReal(target[X_AXIS], target[Y_AXIS], IGNORE_COORDINATE, target[E_AXIS], IGNORE_COORDINATE);
+    nativeArc.requested = false;
+    return true;
+}
 
+/** Turns the line move queueCartesianMove just computed into the requested arc.
+Bresenham now counts rotation iterations, x and y get the path length so the
+feedrate and acceleration limits of calculateMove apply to the path. */
+bool PrintLine::initNativeArc(float axisDistanceMM[]) {
+    int32_t start[2], end[2];
+    for(fast8_t i = X_AXIS; i <= Y_AXIS; i++) {
+        int32_t center = static_cast<int32_t>(floor(nativeArc.center[i] + 0.5f));
+        end[i] = Printer::destinationSteps[i] - center;
+        start[i] = end[i] - ((dir & (X_DIRPOS << i)) ? delta[i] : -delta[i]);
+    }
+    float radius = sqrt(static_cast<float>(start[X_AXIS]) * start[X_AXIS] + static_cast<float>(start[Y_AXIS]) * start[Y_AXIS]);
+    if(radius < 2 || radius > 60000)
+        return false;
+    // Rotation per iteration must be below one step
+    uint8_t shift = 1;
+    while(static_cast<float>(1L << shift) < radius + 1)
+        shift++;
+    int32_t iterations = static_cast<int32_t>(nativeArc.angle / (2.0f * asin(0.5f / static_cast<float>(1L << shift))) + 0.5f);
+    if(iterations < 1)
+        iterations = 1;
+    if(delta[Z_AXIS] > iterations || delta[E_AXIS] > iterations)
+        return false;
+    float length = nativeArc.angle * radius * Printer::invAxisStepsPerMM[X_AXIS];
+    // Start directions from the tangent, the interrupt changes them when needed
+    dir &= ~(X_DIRPOS | Y_DIRPOS);
+    if(nativeArc.clockwise ? start[Y_AXIS] > 0 : start[Y_AXIS] < 0)
+        setPositiveDirectionForAxis(X_AXIS);
+    if(nativeArc.clockwise ? start[X_AXIS] < 0 : start[X_AXIS] > 0)
+        setPositiveDirectionForAxis(Y_AXIS);
+    setMoveOfAxis(X_AXIS);
+    setMoveOfAxis(Y_AXIS);
+    flags |= FLAG_ARC;
+    if(nativeArc.clockwise)
+        flags |= FLAG_ARC_CLOCKWISE;
+    primaryAxis = X_AXIS;
+    stepsRemaining = iterations;
+    delta[X_AXIS] = delta[Y_AXIS] = RMath::max(static_cast<int32_t>(length * Printer::axisStepsPerMM[X_AXIS] + 0.5f), (int32_t)1);
+    axisDistanceMM[X_AXIS] = axisDistanceMM[Y_AXIS] = length;
+    distance = RMath::max(length, fabs(axisDistanceMM[E_AXIS]));
+    for(fast8_t i = X_AXIS; i <= Y_AXIS; i++) {
+        nativeArc.start[i] = start[i];
+        nativeArc.end[i] = end[i];
+    }
+    nativeArc.shift = shift;
+    return true;
+}
 
+/** Sets speedX and speedY to the tangent at radius, used for the junctions. */
+void PrintLine::setNativeArcSpeeds(int32_t *radius, float speed) {
+    float scale = speed / sqrt(static_cast<float>(radius[X_AXIS]) * radius[X_AXIS] + static_cast<float>(radius[Y_AXIS]) * radius[Y_AXIS]);
+    if(isArcClockwise())
+        scale = -scale;
+    speedX = -radius[Y_AXIS] * scale;
+    speedY = radius[X_AXIS] * scale;
+}
+
+/** Stores the circle for the stepper interrupt in fields it does not need for arcs:
+delta holds the start and error the end relative to the center, primaryAxis the shift. */
+void PrintLine::finishNativeArc(float speed) {
+    error[Z_AXIS] = error[E_AXIS] = stepsRemaining >> 1;
+    for(fast8_t i = X_AXIS; i <= Y_AXIS; i++) {
+        delta[i] = nativeArc.start[i];
+        error[i] = nativeArc.end[i];
+    }
+    primaryAxis = nativeArc.shift;
+    setNativeArcSpeeds(nativeArc.end, speed); // for the junction to the next move
+}
+#endif // ARC_NATIVE
+#endif
+
+#if PLANNER_ADVANCE
+static int8_t advanceIdleDirection = 0; // Extruder direction set by advanceIdleStep, 0 = set by move
+
+/** Called by the stepper interrupt without moves. A resting extruder needs no advance, so
+the remaining correction is executed here at maximum extruder speed. A direction change
+gets an own call before the first step. Returns ticks to the next call. */
+uint32_t PrintLine::advanceIdleStep() {
+    Printer::extruderStepsNeeded -= Printer::advanceStepsSet;
+    Printer::advanceStepsSet = 0;
+    Printer::advanceSmoothed = 0;
+    if(Printer::extruderStepsNeeded == 0)
+        return 10000;
+    int8_t direction = Printer::extruderStepsNeeded > 0 ? 1 : -1;
+    if(direction != advanceIdleDirection) {
+        Extruder::setDirection(direction > 0);
+        advanceIdleDirection = direction;
+    } else {
+        Extruder::step();
+        Printer::extruderStepsNeeded -= direction;
+        Printer::insertStepperHighDelay();
+        Extruder::unstep();
+    }
+    return static_cast<uint32_t>(F_CPU / (Printer::maxFeedrate[E_AXIS] * Printer::axisStepsPerMM[E_AXIS]));
+}
+#endif
 
 /**
   Moves the stepper motors one step. If the last step is reached, the next movement is started.
@@ -2193,7 +2558,7 @@ void PrintLine::arc(float *position, float *target, float *offset, float radius,
   Cartesian axis steps may be less than the changing dominant delta axis.
 */
 #if NONLINEAR_SYSTEM
-int lastblk = - 1;
+PrintLine *lastblk = NULL;
 int32_t cur_errupd;
 // Current nonlinear segment
 NonlinearSegment *curd;
@@ -2208,9 +2573,10 @@ int32_t PrintLine::bresenhamStep() { // Version for delta printer
     {
         setCurrentLine();
         if(cur->isBlocked()) { // This step is in computation - shouldn't happen
-            if(lastblk != (int)cur) {
+            EVENT_STEPPER_STARVED;
+            if(lastblk != cur) {
                 HAL::allowInterrupts();
-                lastblk = (int)cur;
+                lastblk = cur;
                 Com::printFLN(Com::tBLK, (int32_t)linesCount);
             }
             cur = NULL;
@@ -2220,7 +2586,7 @@ int32_t PrintLine::bresenhamStep() { // Version for delta printer
             return 2000;
         }
         HAL::allowInterrupts();
-        lastblk = -1;
+        lastblk = NULL;
 #if INCLUDE_DEBUG_NO_MOVE
         if(Printer::debugNoMoves()) { // simulate a move, but do nothing in reality
             removeCurrentLineForbidInterrupt();
@@ -2294,10 +2660,13 @@ int32_t PrintLine::bresenhamStep() { // Version for delta printer
         Printer::stepNumber = 0;
         Printer::timer = 0;
         HAL::forbidInterrupts();
-#if USE_ADVANCE
+#if ADVANCE_EXTRUDER_TIMER
         if(!Printer::isAdvanceActivated()) // Set direction if no advance/OPS enabled
 #endif
             Extruder::setDirection(cur->isEPositiveMove());
+#if PLANNER_ADVANCE
+        advanceIdleDirection = 0;
+#endif
 #if defined(DIRECTION_DELAY) && DIRECTION_DELAY > 0
         // HAL::delayMicroseconds(DIRECTION_DELAY); // We leave interrupt without step so no delay needed here
 #endif
@@ -2364,9 +2733,18 @@ int32_t PrintLine::bresenhamStep() { // Version for delta printer
 #if STEPPER_HIGH_DELAY + DOUBLE_STEP_DELAY
         if(loop > 0)
             HAL::delayMicroseconds(STEPPER_HIGH_DELAY + DOUBLE_STEP_DELAY);
+#endif
+#if PLANNER_ADVANCE
+        if(Printer::isAdvanceActivated()) {
+            bool regular = (cur->error[E_AXIS] -= cur->delta[E_AXIS]) < 0;
+            if(regular)
+                cur->error[E_AXIS] += cur_errupd;
+            if(cur->advanceEStep(regular))
+                Extruder::step();
+        } else
 #endif
         if((cur->error[E_AXIS] -= cur->delta[E_AXIS]) < 0) {
-#if USE_ADVANCE
+#if ADVANCE_EXTRUDER_TIMER
             if(Printer::isAdvanceActivated()) { // Use interrupt for movement
                 if(cur->isEPositiveMove())
                     Printer::extruderStepsNeeded++;
@@ -2378,10 +2756,17 @@ int32_t PrintLine::bresenhamStep() { // Version for delta printer
             cur->error[E_AXIS] += cur_errupd;
         }
         if (curd) {
+#if STEP_PORT_PARALLEL
+            uint8_t axes = 0;
+#endif
             // Take delta steps
             if(curd->isXMove())
                 if((cur->error[X_AXIS] -= curd->deltaSteps[A_TOWER]) < 0) {
+#if STEP_PORT_PARALLEL
+                    axes |= XSTEP;
+#else
                     cur->startXStep();
+#endif
                     cur->error[X_AXIS] += curd_errupd;
 #ifdef DEBUG_REAL_POSITION
                     Printer::realDeltaPositionSteps[A_TOWER] += curd->isXPositiveMove() ? 1 : -1;
@@ -2393,7 +2778,11 @@ int32_t PrintLine::bresenhamStep() { // Version for delta printer
 
             if(curd->isYMove())
                 if((cur->error[Y_AXIS] -= curd->deltaSteps[B_TOWER]) < 0) {
+#if STEP_PORT_PARALLEL
+                    axes |= YSTEP;
+#else
                     cur->startYStep();
+#endif
                     cur->error[Y_AXIS] += curd_errupd;
 #ifdef DEBUG_REAL_POSITION
                     Printer::realDeltaPositionSteps[B_TOWER] += curd->isYPositiveMove() ? 1 : -1;
@@ -2405,13 +2794,20 @@ int32_t PrintLine::bresenhamStep() { // Version for delta printer
 
             if(curd->isZMove())
                 if((cur->error[Z_AXIS] -= curd->deltaSteps[C_TOWER]) < 0) {
+#if STEP_PORT_PARALLEL
+                    axes |= ZSTEP;
+#else
                     cur->startZStep();
+#endif
                     cur->error[Z_AXIS] += curd_errupd;
                     Printer::realDeltaPositionSteps[C_TOWER] += curd->isZPositiveMove() ? 1 : -1;
 #ifdef DEBUG_STEPCOUNT
                     cur->totalStepsRemaining--;
 #endif
                 }
+#if STEP_PORT_PARALLEL
+            cur->startXYZSteps(axes);
+#endif
             stepsPerSegRemaining--;
         }
 #if CPU_ARCH != ARCH_AVR
@@ -2419,7 +2815,7 @@ int32_t PrintLine::bresenhamStep() { // Version for delta printer
 #endif
             Printer::insertStepperHighDelay();
             Printer::endXYZSteps();
-#if USE_ADVANCE
+#if ADVANCE_EXTRUDER_TIMER
             if(!Printer::isAdvanceActivated()) // Use interrupt for movement
 #endif
                 Extruder::unstep();
@@ -2466,8 +2862,12 @@ int32_t PrintLine::bresenhamStep() { // Version for delta printer
 #if RAMP_ACCELERATION
 //If acceleration is enabled on this move and we are in the acceleration segment, calculate the current interval
     if (cur->moveAccelerating()) {
+#if S_CURVE_ACCELERATION
+        Printer::vMaxReached = cur->sCurveAccelerationSpeed();
+#else
         Printer::vMaxReached = HAL::ComputeV(Printer::timer, cur->fAcceleration) + cur->vStart;
         if(Printer::vMaxReached > cur->vMax) Printer::vMaxReached = cur->vMax;
+#endif
         speed_t v = Printer::updateStepsPerTimerCall(Printer::vMaxReached);
         Printer::interval = HAL::CPUDivU2(v);
         // if(Printer::maxInterval < Printer::interval) // fix timing for very slow speeds
@@ -2476,6 +2876,9 @@ int32_t PrintLine::bresenhamStep() { // Version for delta printer
         cur->updateAdvanceSteps(Printer::vMaxReached, maxLoops, true);
         Printer::stepNumber += maxLoops; // is only used by moveAccelerating
     } else if (cur->moveDecelerating()) { // time to slow down
+#if S_CURVE_ACCELERATION
+        speed_t v = cur->sCurveDecelerationSpeed();
+#else
         speed_t v = HAL::ComputeV(Printer::timer, cur->fAcceleration);
         if (v > Printer::vMaxReached)   // if deceleration goes too far it can become too large
             v = cur->vEnd;
@@ -2483,6 +2886,7 @@ int32_t PrintLine::bresenhamStep() { // Version for delta printer
             v = Printer::vMaxReached - v;
             if (v < cur->vEnd) v = cur->vEnd; // extra steps at the end of deceleration due to rounding errors
         }
+#endif
         cur->updateAdvanceSteps(v, maxLoops, false);
         v = Printer::updateStepsPerTimerCall(v);
         Printer::interval = HAL::CPUDivU2(v);
@@ -2494,9 +2898,9 @@ int32_t PrintLine::bresenhamStep() { // Version for delta printer
         // If we started full speed, we need to use cur->fullInterval and vMax
         cur->updateAdvanceSteps((!cur->accelSteps ? cur->vMax : Printer::vMaxReached), 0, true);
         if(!cur->accelSteps) {
-            if(cur->vMax > STEP_DOUBLER_FREQUENCY) {
+            if(cur->vMax > STEP_DOUBLER_LIMIT) {
 #if ALLOW_QUADSTEPPING
-                if(cur->vMax > STEP_DOUBLER_FREQUENCY * 2) {
+                if(cur->vMax > STEP_DOUBLER_LIMIT * 2) {
                     Printer::stepsPerTimerCall = 4;
                     Printer::interval = cur->fullInterval << 2;
                 } else {
@@ -2548,7 +2952,7 @@ int32_t PrintLine::bresenhamStep() { // Version for delta printer
 #if CPU_ARCH != ARCH_AVR
     Printer::insertStepperHighDelay();
     Printer::endXYZSteps();
-#if USE_ADVANCE
+#if ADVANCE_EXTRUDER_TIMER
     if(!Printer::isAdvanceActivated()) // Use interrupt for movement
 #endif
         Extruder::unstep();
@@ -2564,7 +2968,275 @@ int32_t PrintLine::bresenhamStep() { // Version for delta printer
 */
 int lastblk = -1;
 int32_t cur_errupd;
+#if ARC_NATIVE
+int32_t arcPosition[2];     // Position relative to the center, NATIVE_ARC_FRACTION_BITS fraction bits
+int32_t arcStepPosition[2]; // Position of the motors relative to the center
+int32_t arcEnd[2];
+int32_t arcRounding;
+uint8_t arcShift;
+
+void PrintLine::startNativeArc() {
+    for(fast8_t i = X_AXIS; i <= Y_AXIS; i++) {
+        arcStepPosition[i] = delta[i];
+        arcPosition[i] = delta[i] * (1L << NATIVE_ARC_FRACTION_BITS);
+        arcEnd[i] = error[i];
+        delta[i] = error[i] = 0; // Bresenham never steps x and y
+    }
+    arcShift = primaryAxis;
+    arcRounding = 1L << (arcShift - 1);
+}
+
+/** One iteration of the Minsky circle algorithm. x -= y * 2^-shift, y += x * 2^-shift
+with the new x stays within one step of the circle without any multiplication. x and y step
+when the rounded position changes, the last iteration goes to the exact end and is repeated
+until it is reached, with z and e waiting. */
+inline void PrintLine::nativeArcStep() {
+    int32_t target[2];
+    if(stepsRemaining > 1) {
+        if(isArcClockwise()) {
+            arcPosition[X_AXIS] += (arcPosition[Y_AXIS] + arcRounding) >> arcShift;
+            arcPosition[Y_AXIS] -= (arcPosition[X_AXIS] + arcRounding) >> arcShift;
+        } else {
+            arcPosition[X_AXIS] -= (arcPosition[Y_AXIS] + arcRounding) >> arcShift;
+            arcPosition[Y_AXIS] += (arcPosition[X_AXIS] + arcRounding) >> arcShift;
+        }
+        target[X_AXIS] = (arcPosition[X_AXIS] + (1L << (NATIVE_ARC_FRACTION_BITS - 1))) >> NATIVE_ARC_FRACTION_BITS;
+        target[Y_AXIS] = (arcPosition[Y_AXIS] + (1L << (NATIVE_ARC_FRACTION_BITS - 1))) >> NATIVE_ARC_FRACTION_BITS;
+    } else {
+        target[X_AXIS] = arcEnd[X_AXIS];
+        target[Y_AXIS] = arcEnd[Y_AXIS];
+    }
+#if CPU_ARCH == ARCH_AVR
+    bool moveX = isXMove(), moveY = isYMove(); // cleared by endstop hit
+#else
+    bool moveX = true, moveY = true;
+#endif
+    if(moveX && target[X_AXIS] != arcStepPosition[X_AXIS]) {
+        bool positive = target[X_AXIS] > arcStepPosition[X_AXIS];
+        if(positive != ((dir & X_DIRPOS) != 0)) {
+            dir ^= X_DIRPOS;
+#if INPUT_SHAPING
+            InputShaper::setDirection(dir & X_DIRPOS, dir & Y_DIRPOS);
+#else
+            Printer::setXDirection(positive);
+#endif
+#if defined(DIRECTION_DELAY) && DIRECTION_DELAY > 0
+            HAL::delayMicroseconds(DIRECTION_DELAY);
+#endif
+        }
+#if INPUT_SHAPING
+        if(InputShaper::active)
+            InputShaper::x.command(positive, InputShaper::now);
+        else
+#endif
+            Printer::startXStep();
+        arcStepPosition[X_AXIS] += positive ? 1 : -1;
+    }
+    if(moveY && target[Y_AXIS] != arcStepPosition[Y_AXIS]) {
+        bool positive = target[Y_AXIS] > arcStepPosition[Y_AXIS];
+        if(positive != ((dir & Y_DIRPOS) != 0)) {
+            dir ^= Y_DIRPOS;
+#if INPUT_SHAPING
+            InputShaper::setDirection(dir & X_DIRPOS, dir & Y_DIRPOS);
+#else
+            Printer::setYDirection(positive);
+#endif
+#if defined(DIRECTION_DELAY) && DIRECTION_DELAY > 0
+            HAL::delayMicroseconds(DIRECTION_DELAY);
+#endif
+        }
+#if INPUT_SHAPING
+        if(InputShaper::active)
+            InputShaper::y.command(positive, InputShaper::now);
+        else
+#endif
+            Printer::startYStep();
+        arcStepPosition[Y_AXIS] += positive ? 1 : -1;
+    }
+    if(stepsRemaining == 1 && ((moveX && arcStepPosition[X_AXIS] != arcEnd[X_AXIS]) || (moveY && arcStepPosition[Y_AXIS] != arcEnd[Y_AXIS]))) {
+        stepsRemaining++;
+        error[Z_AXIS] += delta[Z_AXIS];
+        error[E_AXIS] += delta[E_AXIS];
+    }
+}
+#endif
+#if STEP_BATCHING
+#if STEP_AXIS_TIMING
+#define STEP_BATCH_SIZE 16 // up to 4 iterations with a step of each axis
+#else
+#define STEP_BATCH_SIZE 4
+#endif
+uint8_t stepBatchAxes[STEP_BATCH_SIZE];  // XSTEP, YSTEP, ZSTEP and ESTEP of each batched step
+ticks_t stepBatchDelay[STEP_BATCH_SIZE]; // Ticks to the next interrupt after each batched step
+ufast8_t stepBatchPos = 0, stepBatchCount = 0;
+
+/** Bresenham iteration without touching the pins. Returns the axes to step. */
+inline uint8_t PrintLine::nextBatchStep() {
+    uint8_t axes = 0;
+#if PLANNER_ADVANCE
+    if(Printer::isAdvanceActivated()) {
+        bool regular = (error[E_AXIS] -= delta[E_AXIS]) < 0;
+        if(regular)
+            error[E_AXIS] += cur_errupd;
+        if(advanceEStep(regular))
+            axes |= ESTEP;
+    } else
+#endif
+    if((error[E_AXIS] -= delta[E_AXIS]) < 0) {
+#if ADVANCE_EXTRUDER_TIMER
+        if(Printer::isAdvanceActivated()) { // Use interrupt for movement
+            if(isEPositiveMove())
+                Printer::extruderStepsNeeded++;
+            else
+                Printer::extruderStepsNeeded--;
+        } else
+#endif
+            axes |= ESTEP;
+        error[E_AXIS] += cur_errupd;
+    }
+    if((error[X_AXIS] -= delta[X_AXIS]) < 0) {
+        axes |= XSTEP;
+        error[X_AXIS] += cur_errupd;
+    }
+    if((error[Y_AXIS] -= delta[Y_AXIS]) < 0) {
+        axes |= YSTEP;
+        error[Y_AXIS] += cur_errupd;
+    }
+    if((error[Z_AXIS] -= delta[Z_AXIS]) < 0) {
+        axes |= ZSTEP;
+        error[Z_AXIS] += cur_errupd;
+#ifdef DEBUG_STEPCOUNT
+        totalStepsRemaining--;
+#endif
+    }
+    stepsRemaining--;
+    return axes;
+}
+
+inline void PrintLine::executeBatchStep(uint8_t axes) {
+#if CPU_ARCH == ARCH_AVR
+    axes &= cur->dir; // cleared by endstop hit
+#endif
+    if(axes & ESTEP)
+        Extruder::step();
+    cur->startXYZSteps(axes);
+    Printer::insertStepperHighDelay();
+    if(axes & ESTEP)
+        Extruder::unstep();
+    Printer::endXYZSteps();
+}
+
+/** Executes the next precomputed step of the current move. Only pins are set here,
+so the interrupt is short enough for one call per step. */
+int32_t PrintLine::replayStepBatch() {
+    cur->checkEndstops();
+    executeBatchStep(stepBatchAxes[stepBatchPos]);
+    return stepBatchDelay[stepBatchPos++];
+}
+#endif
+#if STEP_AXIS_TIMING
+uint16_t stepBatchPhase[STEP_BATCH_SIZE]; // Iteration of each scheduled step with 8 fraction bits
+ufast8_t stepBatchFill = 0;
+
+/** Adds a step sorted by phase. Axes stepping at the same phase share one entry. */
+static inline void addAxisStep(uint8_t axis, uint16_t phase) {
+    ufast8_t i = stepBatchFill;
+    while(i > 0 && stepBatchPhase[i - 1] > phase)
+        i--;
+    if(i > 0 && stepBatchPhase[i - 1] == phase) {
+        stepBatchAxes[i - 1] |= axis;
+        return;
+    }
+    for(ufast8_t j = stepBatchFill; j > i; j--) {
+        stepBatchPhase[j] = stepBatchPhase[j - 1];
+        stepBatchAxes[j] = stepBatchAxes[j - 1];
+    }
+    stepBatchPhase[i] = phase;
+    stepBatchAxes[i] = axis;
+    stepBatchFill++;
+}
+
+/** Bresenham iterations of one interrupt call, but each axis gets the exact time of its step
+instead of stepping with the primary axis. The error before the subtraction divided by delta
+is the part of the iteration that passed when the axis crossed its step. All axes are
+delayed by one iteration, so every step lies in the future of this call. */
+inline void PrintLine::scheduleAxisSteps(fast8_t loops) {
+    stepBatchFill = 0;
+    for(fast8_t loop = 0; loop < loops; loop++) {
+        for(fast8_t axis = X_AXIS; axis <= E_AXIS; axis++) {
+            int32_t before = error[axis];
+#if PLANNER_ADVANCE
+            if(axis == E_AXIS && Printer::isAdvanceActivated()) { // pending steps start with the iteration
+                bool regular = (error[E_AXIS] -= delta[E_AXIS]) < 0;
+                if(regular)
+                    error[E_AXIS] += cur_errupd;
+                if(advanceEStep(regular))
+                    addAxisStep(ESTEP, (loop << 8) + (regular ? (static_cast<uint32_t>(before) << 8) / delta[E_AXIS] : 0));
+                continue;
+            }
+#endif
+            if((error[axis] -= delta[axis]) < 0) {
+                error[axis] += cur_errupd;
+#if ADVANCE_EXTRUDER_TIMER
+                if(axis == E_AXIS && Printer::isAdvanceActivated()) { // Use interrupt for movement
+                    if(isEPositiveMove())
+                        Printer::extruderStepsNeeded++;
+                    else
+                        Printer::extruderStepsNeeded--;
+                    continue;
+                }
+#endif
+#ifdef DEBUG_STEPCOUNT
+                if(axis == Z_AXIS)
+                    totalStepsRemaining--;
+#endif
+                addAxisStep(XSTEP << axis, (loop << 8) + (static_cast<uint32_t>(before) << 8) / delta[axis]);
+            }
+        }
+        stepsRemaining--;
+    }
+}
+
+/** Converts the scheduled phases into ticks of the computed interval. Steps closer than
+STEP_AXIS_TIMING_MIN_TICKS are combined unless the same axis steps twice, steps due now
+are executed at once. Returns ticks to the first interrupt. */
+inline int32_t PrintLine::finishAxisSteps(int32_t interval, fast8_t loops) {
+    ticks_t loopTicks = interval / loops;
+    ticks_t time[STEP_BATCH_SIZE];
+    ticks_t last = 0;
+    uint8_t now = 0;
+    ufast8_t n = 0;
+    for(ufast8_t i = 0; i < stepBatchFill; i++) {
+        uint8_t axes = stepBatchAxes[i];
+        ticks_t t = (stepBatchPhase[i] >> 8) * loopTicks + (((stepBatchPhase[i] & 255) * loopTicks) >> 8);
+        if(t < last + STEP_AXIS_TIMING_MIN_TICKS) {
+            uint8_t &group = (n ? stepBatchAxes[n - 1] : now);
+            if((group & axes) == 0) {
+                group |= axes;
+                continue;
+            }
+            t = last + STEP_AXIS_TIMING_MIN_TICKS;
+        }
+        stepBatchAxes[n] = axes;
+        time[n++] = last = t;
+    }
+    if(now)
+        executeBatchStep(now);
+    for(ufast8_t i = 0; i + 1 < n; i++)
+        stepBatchDelay[i] = time[i + 1] - time[i];
+    if(n == 0)
+        return interval;
+    stepBatchDelay[n - 1] = (static_cast<int32_t>(interval - last) > STEP_AXIS_TIMING_MIN_TICKS ? interval - last : STEP_AXIS_TIMING_MIN_TICKS);
+    stepBatchPos = 0;
+    stepBatchCount = n;
+    return time[0];
+}
+#endif
 int32_t PrintLine::bresenhamStep() { // version for Cartesian printer
+#if STEP_BATCHING
+    if(stepBatchPos < stepBatchCount)
+        return replayStepBatch();
+#endif
 #if CPU_ARCH == ARCH_ARM
     if(!PrintLine::nlFlag)
 #else
@@ -2573,6 +3245,7 @@ int32_t PrintLine::bresenhamStep() { // version for Cartesian printer
     {
         setCurrentLine();
         if(cur->isBlocked()) { // This step is in computation - shouldn't happen
+            EVENT_STEPPER_STARVED;
             /*if(lastblk!=(int)cur) // can cause output errors!
             {
                 HAL::allowInterrupts();
@@ -2613,6 +3286,15 @@ int32_t PrintLine::bresenhamStep() { // version for Cartesian printer
             removeCurrentLineForbidInterrupt();
             return(wait); // waste some time for path optimization to fill up
         } // End if WARMUP
+#if INPUT_SHAPING
+        if(!InputShaper::startMove(Printer::isHoming())) { // unshaped move must wait for delayed steps
+            cur = NULL;
+#if CPU_ARCH == ARCH_ARM
+            PrintLine::nlFlag = false;
+#endif
+            return InputShaper::idleStep(2000);
+        }
+#endif
         //Only enable axis that are moving. If the axis doesn't need to move then it can stay disabled depending on configuration.
 #if GANTRY
 #if DRIVE_SYSTEM == XY_GANTRY || DRIVE_SYSTEM == YX_GANTRY
@@ -2636,7 +3318,13 @@ int32_t PrintLine::bresenhamStep() { // version for Cartesian printer
         if(cur->isEMove()) Extruder::enable();
         cur->fixStartAndEndSpeed();
         HAL::allowInterrupts();
-        cur_errupd = cur->delta[cur->primaryAxis];
+#if ARC_NATIVE
+        if(cur->isArcMove()) {
+            cur_errupd = cur->stepsRemaining;
+            cur->startNativeArc();
+        } else
+#endif
+            cur_errupd = cur->delta[cur->primaryAxis];
         if(!cur->areParameterUpToDate()) { // should never happen, but with bad timings???
             cur->updateStepsParameter();
         }
@@ -2646,8 +3334,12 @@ int32_t PrintLine::bresenhamStep() { // version for Cartesian printer
         HAL::forbidInterrupts();
         //Determine direction of movement,check if endstop was hit
 #if !(GANTRY)
+#if INPUT_SHAPING
+        InputShaper::setDirection(cur->isXPositiveMove(), cur->isYPositiveMove());
+#else
         Printer::setXDirection(cur->isXPositiveMove());
         Printer::setYDirection(cur->isYPositiveMove());
+#endif
         Printer::setZDirection(cur->isZPositiveMove());
 #else // Any gantry type
         long gdx = (cur->dir & X_DIRPOS ? cur->delta[X_AXIS] : -cur->delta[X_AXIS]); // Compute signed difference in steps
@@ -2671,10 +3363,13 @@ int32_t PrintLine::bresenhamStep() { // version for Cartesian printer
 #endif
 #endif // YZ or ZY Gantry
 #endif // GANTRY
-#if USE_ADVANCE
+#if ADVANCE_EXTRUDER_TIMER
         if(!Printer::isAdvanceActivated()) // Set direction if no advance/OPS enabled
 #endif
             Extruder::setDirection(cur->isEPositiveMove());
+#if PLANNER_ADVANCE
+        advanceIdleDirection = 0;
+#endif
 #if defined(DIRECTION_DELAY) && DIRECTION_DELAY > 0
         // HAL::delayMicroseconds(DIRECTION_DELAY); // We leave interrupt without step so no delay needed here
 #endif
@@ -2707,13 +3402,59 @@ int32_t PrintLine::bresenhamStep() { // version for Cartesian printer
     fast8_t max_loops = Printer::stepsPerTimerCall;
     if(cur->stepsRemaining < max_loops)
         max_loops = cur->stepsRemaining;
+#if STEP_AXIS_TIMING
+    // All steps of this call are scheduled at their own time and follow in own
+    // interrupts. The last call of a move steps directly, so the move ends with it.
+    bool batch = cur->stepsRemaining > max_loops
+#elif STEP_BATCHING
+    // Only the first step is done now, the others follow in own interrupts at even
+    // distances. The last call of a move steps directly, so the move ends with it.
+    ufast8_t batched = 0;
+    bool batch = max_loops > 1 && cur->stepsRemaining > max_loops
+#endif
+#if STEP_BATCHING
+#if ARC_NATIVE
+                 && !cur->isArcMove()
+#endif
+#if INPUT_SHAPING
+                 && !InputShaper::active
+#endif
+                 ;
+#endif
+#if STEP_AXIS_TIMING
+    if(batch)
+        cur->scheduleAxisSteps(max_loops);
+    else
+#endif
     for(fast8_t loop = 0; loop < max_loops; loop++) {
+#if STEP_BATCHING && !STEP_AXIS_TIMING
+        if(batch && loop) {
+            stepBatchAxes[batched++] = cur->nextBatchStep();
+            continue;
+        }
+#endif
 #if STEPPER_HIGH_DELAY + DOUBLE_STEP_DELAY > 0
         if(loop)
             HAL::delayMicroseconds(STEPPER_HIGH_DELAY + DOUBLE_STEP_DELAY);
+#endif
+#if ARC_NATIVE
+        if(cur->isArcMove())
+            cur->nativeArcStep();
+#endif
+#if STEP_PORT_PARALLEL
+        uint8_t axes = 0;
+#endif
+#if PLANNER_ADVANCE
+        if(Printer::isAdvanceActivated()) {
+            bool regular = (cur->error[E_AXIS] -= cur->delta[E_AXIS]) < 0;
+            if(regular)
+                cur->error[E_AXIS] += cur_errupd;
+            if(cur->advanceEStep(regular))
+                Extruder::step();
+        } else
 #endif
         if((cur->error[E_AXIS] -= cur->delta[E_AXIS]) < 0) {
-#if USE_ADVANCE
+#if ADVANCE_EXTRUDER_TIMER
             if(Printer::isAdvanceActivated()) { // Use interrupt for movement
                 if(cur->isEPositiveMove())
                     Printer::extruderStepsNeeded++;
@@ -2728,35 +3469,54 @@ int32_t PrintLine::bresenhamStep() { // version for Cartesian printer
         if(cur->isXMove())
 #endif
             if((cur->error[X_AXIS] -= cur->delta[X_AXIS]) < 0) {
+#if STEP_PORT_PARALLEL
+                axes |= XSTEP;
+#else
                 cur->startXStep();
+#endif
                 cur->error[X_AXIS] += cur_errupd;
             }
 #if CPU_ARCH == ARCH_AVR
         if(cur->isYMove())
 #endif
             if((cur->error[Y_AXIS] -= cur->delta[Y_AXIS]) < 0) {
+#if STEP_PORT_PARALLEL
+                axes |= YSTEP;
+#else
                 cur->startYStep();
+#endif
                 cur->error[Y_AXIS] += cur_errupd;
             }
 #if CPU_ARCH == ARCH_AVR
         if(cur->isZMove())
 #endif
             if((cur->error[Z_AXIS] -= cur->delta[Z_AXIS]) < 0) {
+#if STEP_PORT_PARALLEL
+                axes |= ZSTEP;
+#else
                 cur->startZStep();
+#endif
                 cur->error[Z_AXIS] += cur_errupd;
 #ifdef DEBUG_STEPCOUNT
                 cur->totalStepsRemaining--;
 #endif
             }
+#if STEP_PORT_PARALLEL
+        cur->startXYZSteps(axes);
+#endif
 #if (GANTRY)
 #if DRIVE_SYSTEM == XY_GANTRY || DRIVE_SYSTEM == YX_GANTRY
         Printer::executeXYGantrySteps();
 #else
         Printer::executeXZGantrySteps();
 #endif
+#endif
+#if INPUT_SHAPING
+        if(InputShaper::active)
+            InputShaper::step();
 #endif
         Printer::insertStepperHighDelay();
-#if USE_ADVANCE
+#if ADVANCE_EXTRUDER_TIMER
         if(!Printer::isAdvanceActivated()) // Use interrupt for movement
 #endif
             Extruder::unstep();
@@ -2767,8 +3527,12 @@ int32_t PrintLine::bresenhamStep() { // version for Cartesian printer
 #if RAMP_ACCELERATION
     //If acceleration is enabled on this move and we are in the acceleration segment, calculate the current interval
     if (cur->moveAccelerating()) { // we are accelerating
+#if S_CURVE_ACCELERATION
+        Printer::vMaxReached = cur->sCurveAccelerationSpeed();
+#else
         Printer::vMaxReached = HAL::ComputeV(Printer::timer, cur->fAcceleration) + cur->vStart; // v = v0 + a * t
         if(Printer::vMaxReached > cur->vMax) Printer::vMaxReached = cur->vMax;
+#endif
         unsigned int v = Printer::updateStepsPerTimerCall(Printer::vMaxReached);
         Printer::interval = HAL::CPUDivU2(v);
         // if(Printer::maxInterval < Printer::interval) // fix timing for very slow speeds
@@ -2777,6 +3541,9 @@ int32_t PrintLine::bresenhamStep() { // version for Cartesian printer
         cur->updateAdvanceSteps(Printer::vMaxReached, max_loops, true);
         Printer::stepNumber += max_loops; // only used for moveAccelerating
     } else if (cur->moveDecelerating()) { // time to slow down
+#if S_CURVE_ACCELERATION
+        unsigned int v = cur->sCurveDecelerationSpeed();
+#else
         unsigned int v = HAL::ComputeV(Printer::timer, cur->fAcceleration);
         if (v > Printer::vMaxReached)   // if deceleration goes too far it can become too large
             v = cur->vEnd;
@@ -2784,6 +3551,7 @@ int32_t PrintLine::bresenhamStep() { // version for Cartesian printer
             v = Printer::vMaxReached - v;
             if (v < cur->vEnd) v = cur->vEnd; // extra steps at the end of deceleration due to rounding errors
         }
+#endif
         cur->updateAdvanceSteps(v, max_loops, false); // needs original v
         v = Printer::updateStepsPerTimerCall(v);
         Printer::interval = HAL::CPUDivU2(v);
@@ -2793,9 +3561,9 @@ int32_t PrintLine::bresenhamStep() { // version for Cartesian printer
     } else { // full speed reached
         cur->updateAdvanceSteps((!cur->accelSteps ? cur->vMax : Printer::vMaxReached), 0, true);
         // constant speed reached
-        if(cur->vMax > STEP_DOUBLER_FREQUENCY) {
+        if(cur->vMax > STEP_DOUBLER_LIMIT) {
 #if ALLOW_QUADSTEPPING
-            if(cur->vMax > STEP_DOUBLER_FREQUENCY * 2) {
+            if(cur->vMax > STEP_DOUBLER_LIMIT * 2) {
                 Printer::stepsPerTimerCall = 4;
                 Printer::interval = cur->fullInterval << 2;
             } else {
@@ -2841,6 +3609,20 @@ int32_t PrintLine::bresenhamStep() { // version for Cartesian printer
         interval = Printer::interval = interval >> 1; // 50% of time to next call to do cur=0
         DEBUG_MEMORY;
     } // Do even
+#if STEP_AXIS_TIMING
+    else if(batch)
+        interval = finishAxisSteps(interval, max_loops);
+#elif STEP_BATCHING
+    else if(batched) { // spread the steps over the interval
+        ticks_t stepInterval = interval / (batched + 1);
+        for(ufast8_t i = 0; i < batched; i++)
+            stepBatchDelay[i] = stepInterval;
+        stepBatchDelay[batched - 1] = interval - batched * stepInterval;
+        stepBatchPos = 0;
+        stepBatchCount = batched;
+        interval = stepInterval;
+    }
+#endif
 #if FEATURE_BABYSTEPPING
     if(Printer::zBabystepsMissing) {
         HAL::forbidInterrupts();
@@ -0,0 +1,101 @@
+/*
+    Minimal Arduino core replacement for the host simulator. Only the parts
+    used by the firmware are provided.
+*/
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+
+#define ARDUINO 10600
+
+#define HIGH 0x1
+#define LOW  0x0
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define SERIAL_BUFFER_SIZE 128
+
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+class Print
+{
+  public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t) = 0;
+    size_t write(const char *str) {
+      size_t n = 0;
+      while(*str) n += write((uint8_t)*str++);
+      return n;
+    }
+    size_t write(const uint8_t *buffer, size_t size) {
+      size_t n = 0;
+      while(size--) n += write(*buffer++);
+      return n;
+    }
+};
+
+class Stream : public Print
+{
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    virtual void flush() = 0;
+};
+
+/** Serial port of the simulator. Input comes from a memory buffer filled by
+the simulator driver, output goes to a stdio stream. */
+class HostSerial : public Stream
+{
+    const uint8_t *input;
+    size_t inputLength;
+    size_t inputPos;
+    FILE *output;
+    uint8_t okState; ///< 0 line start, 1 after 'o', 2 line starts with "ok", 3 other line
+    size_t lineEnd();
+  public:
+    uint32_t okLines; ///< Lines written that start with "ok"
+    HostSerial(FILE *out);
+    void begin(unsigned long baud) {}
+    void end() {}
+    void setInput(const uint8_t *data, size_t length);
+    void setOutput(FILE *f) {
+      output = f;
+    }
+    bool inputFinished() {
+      return inputPos >= inputLength;
+    }
+    virtual int available();
+    virtual int read();
+    virtual int peek();
+    virtual void flush();
+    int readLine(uint8_t *buffer, int maxLength);
+    bool lineAvailable() {
+      return lineEnd() < inputLength;
+    }
+    virtual size_t write(uint8_t c);
+    using Print::write;
+};
+extern HostSerial Serial;
+extern HostSerial SerialUSB;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+void analogWrite(uint8_t pin, int value);
+
+#endif // ARDUINO_H
@@ -0,0 +1,15 @@
+#ifndef CUSTOM_EVENTS_H_INCLUDED
+#define CUSTOM_EVENTS_H_INCLUDED
+
+// The simulated clock advances every time the main loop passes this event.
+#undef EVENT_PERIODICAL
+#define EVENT_PERIODICAL {HAL::simulatorIdle();}
+
+#undef EVENT_PLANNER_UPDATE_START
+#define EVENT_PLANNER_UPDATE_START {HAL::plannerUpdateStart();}
+#undef EVENT_PLANNER_UPDATE_END
+#define EVENT_PLANNER_UPDATE_END {HAL::plannerUpdateEnd();}
+#undef EVENT_STEPPER_STARVED
+#define EVENT_STEPPER_STARVED {HAL::stepperStarved++;}
+
+#endif //CUSTOM_EVENTS_H_INCLUDED
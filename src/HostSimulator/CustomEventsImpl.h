@@ -0,0 +1 @@
+// The host simulator needs no event implementations, see CustomEvents.h.
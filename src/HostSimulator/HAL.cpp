@@ -0,0 +1,439 @@
+/*
+    This file is part of Repetier-Firmware.
+
+    Repetier-Firmware is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Repetier-Firmware is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Repetier-Firmware.  If not, see <http://www.gnu.org/licenses/>.
+
+    This firmware is a nearly complete rewrite of the sprinter firmware
+    by kliment (https://github.com/kliment/Sprinter)
+    which based on Tonokip RepRap firmware rewrite based off of Hydra-mmm firmware.
+*/
+
+#include "Repetier.h"
+#include <time.h>
+
+char HAL::virtualEeprom[EEPROM_BYTES];
+bool HAL::wdPinged = true;
+volatile uint8_t HAL::insideTimer1 = 0;
+uint64_t HAL::simulatorTicks = 0;
+HostPinTracer HAL::pinTracer = NULL;
+uint8_t HAL::pinState[256];
+uint32_t HAL::plannerCostTicks = 0;
+uint32_t HAL::plannerUpdates = 0;
+uint64_t HAL::plannerHostNanos = 0;
+uint64_t HAL::plannerMaxHostNanos = 0;
+uint32_t HAL::stepperStarved = 0;
+uint64_t HAL::simulatorHostNanos = 0;
+Pio hostPio[4] = {{{0, 1}, {0, 0}}, {{32, 1}, {32, 0}}, {{64, 1}, {64, 0}}, {{96, 1}, {96, 0}}};
+
+void PioOutputRegister::operator=(uint32_t mask) {
+    for(uint8_t i = 0; i < 32; i++)
+        if(mask & (1UL << i))
+            HAL::simulatorWrite(firstPin + i, value);
+}
+
+// Next simulated tick each timer fires. 0 = timer not started.
+static uint64_t stepperNextTick = 0;
+static uint64_t pwmNextTick = 0;
+#if ADVANCE_EXTRUDER_TIMER
+static uint64_t extruderNextTick = 0;
+static uint32_t extruderTimerTicks = 0;
+#endif
+static bool insideInterrupt = false;
+static bool plannerCostPending = false;
+static uint64_t plannerStartNanos;
+static uint64_t plannerStartSimulatorNanos;
+
+#define PWM_TIMER_TICKS (F_CPU / PWM_CLOCK_FREQ)
+#ifndef STEPPERTIMER_EXIT_TICKS
+#define STEPPERTIMER_EXIT_TICKS 105 // at least 2,5us pause between stepper calls
+#endif
+
+HAL::HAL() {
+    //ctor
+}
+
+HAL::~HAL() {
+    //dtor
+}
+
+/** No switch is ever pressed, so the endstop inputs start at the level of an open
+switch. Zero would read as triggered for inverting endstops. */
+void HAL::hwSetup(void) {
+    memset(virtualEeprom, 0, EEPROM_BYTES);
+#if X_MIN_PIN > -1
+    pinState[X_MIN_PIN] = ENDSTOP_X_MIN_INVERTING;
+#endif
+#if Y_MIN_PIN > -1
+    pinState[Y_MIN_PIN] = ENDSTOP_Y_MIN_INVERTING;
+#endif
+#if Z_MIN_PIN > -1
+    pinState[Z_MIN_PIN] = ENDSTOP_Z_MIN_INVERTING;
+#endif
+#if X_MAX_PIN > -1
+    pinState[X_MAX_PIN] = ENDSTOP_X_MAX_INVERTING;
+#endif
+#if Y_MAX_PIN > -1
+    pinState[Y_MAX_PIN] = ENDSTOP_Y_MAX_INVERTING;
+#endif
+#if Z_MAX_PIN > -1
+    pinState[Z_MAX_PIN] = ENDSTOP_Z_MAX_INVERTING;
+#endif
+}
+
+// Set up all timer interrupts
+void HAL::setupTimer() {
+#if ADVANCE_EXTRUDER_TIMER
+    extruderTimerTicks = F_CPU / EXTRUDER_CLOCK_FREQ;
+    extruderNextTick = simulatorTicks + extruderTimerTicks;
+#endif
+    pwmNextTick = simulatorTicks + PWM_TIMER_TICKS;
+    stepperNextTick = simulatorTicks + F_CPU / TIMER1_CLOCK_FREQ;
+}
+
+void HAL::analogStart(void) {
+#if ANALOG_INPUTS > 0
+    for(uint8_t i = 0; i < ANALOG_INPUTS; i++)
+        osAnalogInputValues[i] = 0;
+#endif
+}
+
+void HAL::showStartReason() {
+    Com::printInfoFLN(Com::tPowerUp);
+}
+
+int HAL::getFreeRam() {
+    return MAX_RAM;
+}
+
+void HAL::resetHardware() {
+    exit(0);
+}
+
+// from http://medialab.freaknet.org/martin/src/sqrt/sqrt.c
+uint32_t HAL::integer64Sqrt(uint64_t a_nInput) {
+    uint64_t op  = a_nInput;
+    uint64_t res = 0;
+    uint64_t one = 1uLL << 62; // The second-to-top bit is set: use 1u << 14 for uint16_t type; use 1uL<<30 for uint32_t type
+
+    // "one" starts at the highest power of four <= than the argument.
+    while (one > op)
+        one >>= 2;
+    while (one != 0) {
+        if (op >= res + one) {
+            op = op - (res + one);
+            res = res +  2 * one;
+        }
+        res >>= 1;
+        one >>= 2;
+    }
+    if (op > res) { // Do arithmetic rounding to nearest integer
+        res++;
+    }
+    return res;
+}
+
+#if FEATURE_SERVO
+unsigned int HAL::servoTimings[4] = {0, 0, 0, 0};
+void HAL::servoMicroseconds(uint8_t servo, int microsec, uint16_t autoOff) {
+    servoTimings[servo] = microsec;
+}
+#endif
+
+void HAL::delayMicroseconds(uint32_t usec) {
+    uint32_t ticks = usec * (F_CPU / 1000000);
+    if(insideInterrupt) // interrupts can not be interrupted, time just passes
+        simulatorTicks += ticks;
+    else
+        simulatorAdvance(ticks);
+}
+
+/** \brief Timer interrupt routine to drive the stepper motors.
+
+Same logic as the Due version. Returns the tick of the next call.
+*/
+static uint64_t TIMER1_COMPA_VECTOR () {
+    ISR_LOAD_MEASURE(stepper);
+    uint64_t start = HAL::simulatorTicks;
+    uint32_t delay;
+    if (PrintLine::hasLines()) {
+        delay = PrintLine::bresenhamStep();
+    }
+#if INPUT_SHAPING
+    else if (!InputShaper::isIdle()) {
+        delay = InputShaper::idleStep(10000);
+    }
+#endif
+#if FEATURE_BABYSTEPPING
+    else if (Printer::zBabystepsMissing != 0) {
+        Printer::zBabystep();
+        delay = Printer::interval;
+    }
+#endif
+#if PLANNER_ADVANCE
+    else if (Printer::extruderStepsNeeded != 0 || Printer::advanceStepsSet != 0) {
+        delay = PrintLine::advanceIdleStep();
+    }
+#endif
+    else {
+        if (waitRelax == 0) {
+#if USE_ADVANCE
+            if (Printer::advanceStepsSet) {
+                Printer::extruderStepsNeeded -= Printer::advanceStepsSet;
+#if ENABLE_QUADRATIC_ADVANCE
+                Printer::advanceExecuted = 0;
+#endif
+                Printer::advanceStepsSet = 0;
+            }
+            if ((!Printer::extruderStepsNeeded) && (DISABLE_E))
+                Extruder::disableCurrentExtruderMotor();
+#else
+            if (DISABLE_E) Extruder::disableCurrentExtruderMotor();
+#endif
+        } else waitRelax--;
+
+        delay = 10000;
+    }
+#if INPUT_SHAPING
+    InputShaper::advanceTime(delay);
+#endif
+    // Time spent inside the interrupt (delays) is measured in timer clocks like on the Due.
+    uint64_t spent = (HAL::simulatorTicks - start) * TIMER1_PRESCALE;
+    uint64_t timer_count = static_cast<uint64_t>(delay) * TIMER1_PRESCALE;
+    if(spent + STEPPERTIMER_EXIT_TICKS > timer_count) {
+        timer_count = spent + STEPPERTIMER_EXIT_TICKS;
+        ISR_LOAD_OVERRUN;
+    }
+    return start + (timer_count + TIMER1_PRESCALE - 1) / TIMER1_PRESCALE;
+}
+
+/**
+This timer is called 10000 times per second. Heater PWM is not simulated, it
+only drives the 100ms timer and the fast ui action.
+*/
+static void PWM_TIMER_VECTOR () {
+    ISR_LOAD_MEASURE(pwm);
+    counterPeriodical++; // Approximate a 100ms timer
+    if (counterPeriodical >= PWM_COUNTER_100MS) { //  (int)(F_CPU/40960))
+        counterPeriodical = 0;
+        executePeriodical = 1;
+#if FEATURE_FAN_CONTROL
+        if (fanKickstart) fanKickstart--;
+#endif
+#if FEATURE_FAN2_CONTROL
+        if (fan2Kickstart) fan2Kickstart--;
+#endif
+    }
+    UI_FAST; // Short timed user interface action
+}
+
+#if ADVANCE_EXTRUDER_TIMER
+#ifndef ADVANCE_DIR_FILTER_STEPS
+#define ADVANCE_DIR_FILTER_STEPS 2
+#endif
+
+static int extruderLastDirection = 0;
+void HAL::resetExtruderDirection() {
+    extruderLastDirection = 0;
+}
+/** \brief Timer routine for extruder stepper. Same logic as the Due version. */
+static void EXTRUDER_TIMER_VECTOR () {
+    ISR_LOAD_MEASURE(extruder);
+    if (!Printer::isAdvanceActivated()) return; // currently no need
+    if (Printer::extruderStepsNeeded > 0 && extruderLastDirection != 1) {
+        if(Printer::extruderStepsNeeded >= ADVANCE_DIR_FILTER_STEPS) {
+            Extruder::setDirection(true);
+            extruderLastDirection = 1;
+        }
+        extruderTimerTicks = Printer::maxExtruderSpeed * 8; // Due counts with F_CPU_TRUE / 32
+    } else if (Printer::extruderStepsNeeded < 0 && extruderLastDirection != -1) {
+        if(-Printer::extruderStepsNeeded >= ADVANCE_DIR_FILTER_STEPS) {
+            Extruder::setDirection(false);
+            extruderLastDirection = -1;
+        }
+        extruderTimerTicks = Printer::maxExtruderSpeed * 8;
+    } else if (Printer::extruderStepsNeeded != 0) {
+        Extruder::step();
+        Printer::extruderStepsNeeded -= extruderLastDirection;
+        extruderTimerTicks = Printer::maxExtruderSpeed * 8;
+        Printer::insertStepperHighDelay();
+        Extruder::unstep();
+    }
+    if(extruderTimerTicks < 1)
+        extruderTimerTicks = 1;
+}
+#endif
+
+uint64_t HAL::hostNanos() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + ts.tv_nsec;
+}
+
+void HAL::plannerUpdateStart() {
+    plannerCostPending = plannerCostTicks > 0;
+    plannerStartSimulatorNanos = simulatorHostNanos;
+    plannerStartNanos = hostNanos();
+}
+
+/** Host time of interrupts run for the planner cost is not counted. */
+void HAL::plannerUpdateEnd() {
+    uint64_t spent = hostNanos() - plannerStartNanos - (simulatorHostNanos - plannerStartSimulatorNanos);
+    plannerCostPending = false;
+    plannerUpdates++;
+    plannerHostNanos += spent;
+    if(spent > plannerMaxHostNanos)
+        plannerMaxHostNanos = spent;
+}
+
+/** The planner enables interrupts while it holds blocked moves. Let the
+planner cost pass here, so the stepper interrupt sees what the planner blocks. */
+void HAL::plannerPreempt() {
+    if(!plannerCostPending) return;
+    plannerCostPending = false;
+    simulatorAdvance(plannerCostTicks);
+}
+
+void InterruptProtectedBlock::unprotect() {
+    HAL::plannerPreempt();
+}
+
+void HAL::resetStatistics() {
+    plannerUpdates = 0;
+    plannerHostNanos = 0;
+    plannerMaxHostNanos = 0;
+    stepperStarved = 0;
+    simulatorHostNanos = 0;
+}
+
+/** Runs all interrupts in the order they get due until ticks have passed.
+Interrupts with the same due time run in priority order stepper, extruder, pwm. */
+void HAL::simulatorAdvance(uint32_t ticks) {
+    if(insideInterrupt) {
+        simulatorTicks += ticks;
+        return;
+    }
+    uint64_t hostStart = hostNanos();
+    uint64_t target = simulatorTicks + ticks;
+    insideInterrupt = true;
+    while(true) {
+        uint64_t next = target;
+        if(stepperNextTick && stepperNextTick < next) next = stepperNextTick;
+        if(pwmNextTick && pwmNextTick < next) next = pwmNextTick;
+#if ADVANCE_EXTRUDER_TIMER
+        if(extruderNextTick && extruderNextTick < next) next = extruderNextTick;
+#endif
+        if(next >= target) break;
+        if(next > simulatorTicks)
+            simulatorTicks = next;
+        if(stepperNextTick == next) {
+            insideTimer1 = 1;
+            stepperNextTick = TIMER1_COMPA_VECTOR();
+            insideTimer1 = 0;
+        }
+#if ADVANCE_EXTRUDER_TIMER
+        else if(extruderNextTick == next) {
+            EXTRUDER_TIMER_VECTOR();
+            extruderNextTick = next + extruderTimerTicks;
+        }
+#endif
+        else {
+            PWM_TIMER_VECTOR();
+            pwmNextTick = next + PWM_TIMER_TICKS;
+        }
+    }
+    if(simulatorTicks < target)
+        simulatorTicks = target;
+    insideInterrupt = false;
+    simulatorHostNanos += hostNanos() - hostStart;
+}
+
+// ---- Arduino core replacement ----
+
+HostSerial Serial(stdout);
+HostSerial SerialUSB(NULL); // native USB port of SERIAL_USB_SOURCE, quiet unless a test sets an output
+
+HostSerial::HostSerial(FILE *out) {
+    input = NULL;
+    inputLength = inputPos = 0;
+    output = out;
+    okState = 0;
+    okLines = 0;
+}
+void HostSerial::setInput(const uint8_t *data, size_t length) {
+    input = data;
+    inputLength = length;
+    inputPos = 0;
+}
+int HostSerial::available() {
+    return static_cast<int>(inputLength - inputPos);
+}
+int HostSerial::read() {
+    if(inputPos >= inputLength) return -1;
+    return input[inputPos++];
+}
+/** All input is received at once, so a line is complete if a line end follows. */
+size_t HostSerial::lineEnd() {
+    size_t end = inputPos;
+    while(end < inputLength && input[end] != '\n' && input[end] != '\r' && input[end] != 0) end++;
+    return end;
+}
+int HostSerial::readLine(uint8_t *buffer, int maxLength) {
+    size_t end = lineEnd();
+    if(end == inputLength) return 0;
+    int n = 0;
+    while(n < maxLength && inputPos <= end)
+        buffer[n++] = input[inputPos++];
+    return n;
+}
+int HostSerial::peek() {
+    if(inputPos >= inputLength) return -1;
+    return input[inputPos];
+}
+void HostSerial::flush() {
+    if(output != NULL) fflush(output);
+}
+size_t HostSerial::write(uint8_t c) {
+    if(output != NULL) fputc(c, output);
+    if(c == '\n') {
+        if(okState == 2) okLines++;
+        okState = 0;
+    } else if(okState == 0)
+        okState = (c == 'o' ? 1 : 3);
+    else if(okState == 1)
+        okState = (c == 'k' ? 2 : 3);
+    return 1;
+}
+
+unsigned long millis() {
+    return HAL::timeInMilliseconds();
+}
+unsigned long micros() {
+    return static_cast<unsigned long>(HAL::simulatorTicks / (F_CPU / 1000000));
+}
+void delay(unsigned long ms) {
+    HAL::delayMilliseconds(ms);
+}
+void delayMicroseconds(unsigned int us) {
+    HAL::delayMicroseconds(us);
+}
+void pinMode(uint8_t pin, uint8_t mode) {}
+void digitalWrite(uint8_t pin, uint8_t value) {
+    HAL::simulatorWrite(pin, value);
+}
+int digitalRead(uint8_t pin) {
+    return HAL::simulatorRead(pin);
+}
+void analogWrite(uint8_t pin, int value) {
+    HAL::simulatorWrite(pin, value != 0);
+}
@@ -0,0 +1,407 @@
+/*
+    This file is part of Repetier-Firmware.
+
+    Repetier-Firmware is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Repetier-Firmware is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Repetier-Firmware.  If not, see <http://www.gnu.org/licenses/>.
+
+    This firmware is a nearly complete rewrite of the sprinter firmware
+    by kliment (https://github.com/kliment/Sprinter)
+    which based on Tonokip RepRap firmware rewrite based off of Hydra-mmm firmware.
+*/
+
+/**
+  Hardware Abstraction Layer for the host simulator.
+
+  This HAL builds the hardware independent firmware files with a normal
+  host compiler. There is no real hardware and no real time. Instead the HAL
+  keeps a simulated clock counted in F_CPU ticks. The main loop advances this
+  clock by HOST_LOOP_TICKS every time it passes EVENT_PERIODICAL and all timer
+  interrupts that got due in the meantime are executed at their exact tick.
+  Every pin change is handed to a trace writer, so a replayed G-code file
+  produces a deterministic list of step edges.
+
+  Timing follows the Arduino Due HAL (same F_CPU, prescaler and ISR code),
+  so results can be compared with the ARM build.
+*/
+
+#ifndef HAL_H
+#define HAL_H
+
+#include <inttypes.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include "pins.h"
+#include "Arduino.h"
+#include "fastio.h"
+
+// Same virtual clock as the Due HAL, so all timing constants match.
+#undef F_CPU
+#define F_CPU       21000000        // should be factor of F_CPU_TRUE
+#define F_CPU_TRUE  84000000        // actual CPU clock frequency
+#define EEPROM_BYTES 4096  // bytes of eeprom we simulate
+#define SUPPORT_64_BIT_MATH  // Gives better results with high resultion deltas
+#define INT32_IS_INT // int32_t is a typedef of int, skip the duplicate int overloads
+
+#define PACK    __attribute__ ((packed))
+
+#define INLINE __attribute__((always_inline))
+
+// no program space memory on host
+#define PROGMEM
+#define PGM_P const char *
+typedef char prog_char;
+#undef PSTR
+#define PSTR(s) s
+#undef pgm_read_byte_near
+#define pgm_read_byte_near(x) (*(int8_t*)x)
+#undef pgm_read_byte
+#define pgm_read_byte(x) (*(int8_t*)x)
+#undef pgm_read_float
+#define pgm_read_float(addr) (*(const float *)(addr))
+#undef pgm_read_word
+#define pgm_read_word(addr) (*(addr))
+#undef pgm_read_word_near
+#define pgm_read_word_near(addr) pgm_read_word(addr)
+#undef pgm_read_dword
+#define pgm_read_dword(addr) (*(addr))
+#undef pgm_read_dword_near
+#define pgm_read_dword_near(addr) pgm_read_dword(addr)
+#define _BV(x) (1 << (x))
+
+#define FSTRINGVALUE(var,value) const char var[] PROGMEM = value;
+#define FSTRINGVAR(var) static const char var[] PROGMEM;
+#define FSTRINGPARAM(var) PGM_P var
+
+#define EXTRUDER_TIMER_VECTOR   hostExtruderTimerVector
+#define PWM_TIMER_VECTOR        hostPwmTimerVector
+#define TIMER1_COMPA_VECTOR     hostTimer1CompaVector
+
+#define EXTRUDER_CLOCK_FREQ     60000 // extruder stepper interrupt frequency
+#define PWM_CLOCK_FREQ          10000
+#define PWM_COUNTER_100MS       1000
+#define TIMER1_CLOCK_FREQ       244
+#define TIMER1_PRESCALE         2
+
+/** Simulated cost of one pass through the main loop in F_CPU ticks. Every time
+the firmware reaches EVENT_PERIODICAL this much time passes and all due
+interrupts get executed. */
+#ifndef HOST_LOOP_TICKS
+#define HOST_LOOP_TICKS 210 // 10us
+#endif
+
+#define PULLUP(IO,v)            {}
+
+#define EEPROM_OFFSET               0
+#define SECONDS_TO_TICKS(s) (unsigned long)(s*(float)F_CPU)
+#define ANALOG_INPUT_SAMPLE 6
+#define ANALOG_INPUT_MEDIAN 10
+
+// Bits of the ADC converter
+#define ANALOG_INPUT_BITS 12
+#define ANALOG_REDUCE_BITS 0
+#define ANALOG_REDUCE_FACTOR 1
+
+// maximum available RAM
+#define MAX_RAM 98303
+
+#define bit_clear(x,y) x&= ~(1<<y) //cbi(x,y)
+#define bit_set(x,y)   x|= (1<<y)//sbi(x,y)
+
+/** defines the data direction (reading from I2C device) in i2cStart(),i2cRepStart() */
+#define I2C_READ    1
+/** defines the data direction (writing to I2C device) in i2cStart(),i2cRepStart() */
+#define I2C_WRITE   0
+
+/** Set max. frequency to 500000 Hz */
+#define LIMIT_INTERVAL (F_CPU/500000)
+
+typedef unsigned int speed_t;
+typedef unsigned long ticks_t;
+typedef unsigned long millis_t;
+typedef unsigned int flag8_t;
+typedef int fast8_t;
+typedef unsigned int ufast8_t;
+
+#ifndef RFSERIAL
+#define RFSERIAL Serial
+#endif
+#define SERIAL_LINE_BUFFER 1 // RFSERIAL.readLine and lineAvailable are available
+
+// Interrupts can not happen while the main code runs, they are only executed
+// inside HAL::simulatorAdvance, so protection is a no-op. The only exception is
+// the simulated planner cost, see HAL::plannerCostTicks.
+class InterruptProtectedBlock {
+  public:
+    INLINE void protect() {}
+    void unprotect();
+    INLINE InterruptProtectedBlock(bool later = false) {}
+    INLINE ~InterruptProtectedBlock() {}
+};
+
+union eeval_t {
+  uint8_t     b[4];
+  float       f;
+  uint32_t    i;
+  uint16_t    s;
+  int32_t     l;
+} PACK;
+
+/** Receives every pin change of the simulator. tick is the simulated time in F_CPU ticks. */
+typedef void (*HostPinTracer)(uint64_t tick, uint8_t pin, uint8_t value);
+
+class HAL
+{
+  public:
+    static char virtualEeprom[EEPROM_BYTES];
+    static bool wdPinged;
+
+    HAL();
+    virtual ~HAL();
+
+    static void hwSetup(void);
+
+    static uint32_t integer64Sqrt(uint64_t a);
+    static inline uint16_t integerSqrt(uint32_t a) {
+        return integer64Sqrt(a);
+    }
+    // return val'val
+    static inline unsigned long U16SquaredToU32(unsigned int val)
+    {
+      return (unsigned long) val * (unsigned long) val;
+    }
+    static inline unsigned int ComputeV(long timer, long accel)
+    {
+      return static_cast<unsigned int>((static_cast<int64_t>(timer) * static_cast<int64_t>(accel)) >> 18);
+    }
+    // Multiply two 16 bit values and return 32 bit result
+    static inline unsigned long mulu16xu16to32(unsigned int a, unsigned int b)
+    {
+      return (unsigned long) a * (unsigned long) b;
+    }
+    // Multiply two 16 bit values and return 32 bit result
+    static inline unsigned int mulu6xu16shift16(unsigned int a, unsigned int b)
+    {
+      return ((unsigned long)a * (unsigned long)b) >> 16;
+    }
+    static inline unsigned int Div4U2U(unsigned long a, unsigned int b)
+    {
+      return ((unsigned long)a / (unsigned long)b);
+    }
+    static inline void digitalWrite(uint8_t pin, uint8_t value)
+    {
+      simulatorWrite(pin, value);
+    }
+    static inline uint8_t digitalRead(uint8_t pin)
+    {
+      return simulatorRead(pin);
+    }
+    static inline void pinMode(uint8_t pin, uint8_t mode)
+    {
+    }
+    static long CPUDivU2(speed_t divisor) {
+      return F_CPU / divisor;
+    }
+    static void delayMicroseconds(uint32_t usec);
+    static inline void delayMilliseconds(unsigned int delayMs)
+    {
+      delayMicroseconds(delayMs * 1000UL);
+    }
+    static inline void tone(uint8_t pin, int frequency) {}
+    static inline void noTone(uint8_t pin) {}
+
+    static inline void eprSetByte(unsigned int pos, uint8_t value)
+    {
+      *(uint8_t*)&virtualEeprom[pos] = value;
+    }
+    static inline void eprSetInt16(unsigned int pos, int16_t value)
+    {
+      memcopy2(&virtualEeprom[pos],&value);
+    }
+    static inline void eprSetInt32(unsigned int pos, int32_t value)
+    {
+      memcopy4(&virtualEeprom[pos],&value);
+    }
+    static inline void eprSetLong(unsigned int pos, int32_t value)
+    {
+      memcopy4(&virtualEeprom[pos],&value);
+    }
+    static inline void eprSetFloat(unsigned int pos, float value)
+    {
+      memcopy4(&virtualEeprom[pos],&value);
+    }
+    static inline uint8_t eprGetByte(unsigned int pos)
+    {
+      return *(uint8_t*)&virtualEeprom[pos];
+    }
+    static inline int16_t eprGetInt16(unsigned int pos)
+    {
+      int16_t v;
+      memcopy2(&v,&virtualEeprom[pos]);
+      return v;
+    }
+    static inline int32_t eprGetInt32(unsigned int pos)
+    {
+      int32_t v;
+      memcopy4(&v,&virtualEeprom[pos]);
+      return v;
+    }
+    static inline int32_t eprGetLong(unsigned int pos)
+    {
+      int32_t v;
+      memcopy4(&v,&virtualEeprom[pos]);
+      return v;
+    }
+    static inline float eprGetFloat(unsigned int pos) {
+      float v;
+      memcopy4(&v,&virtualEeprom[pos]);
+      return v;
+    }
+
+    static inline void allowInterrupts()
+    {
+    }
+    static inline void forbidInterrupts()
+    {
+    }
+    static inline unsigned long timeInMilliseconds()
+    {
+      return static_cast<unsigned long>(simulatorTicks / (F_CPU / 1000));
+    }
+#define HAL_CYCLE_COUNTER 1
+    /** Simulated timer ticks. Only delays inside an interrupt take simulated time. */
+    static inline uint32_t cycleCounter()
+    {
+      return static_cast<uint32_t>(simulatorTicks);
+    }
+    static inline char readFlashByte(PGM_P ptr)
+    {
+      return pgm_read_byte(ptr);
+    }
+    static inline int16_t readFlashWord(PGM_P ptr)
+    {
+        return pgm_read_word(ptr);
+    }
+
+    static inline void serialSetBaudrate(long baud)
+    {
+      RFSERIAL.begin(baud);
+    }
+    static inline bool serialByteAvailable()
+    {
+      return RFSERIAL.available();
+    }
+    static inline uint8_t serialReadByte()
+    {
+      return RFSERIAL.read();
+    }
+    static inline void serialWriteByte(char b)
+    {
+      RFSERIAL.write(b);
+    }
+    static inline void serialFlush()
+    {
+      RFSERIAL.flush();
+    }
+    static void setupTimer();
+    static void showStartReason();
+    static int getFreeRam();
+    static void resetHardware();
+
+    // SPI and I2C are not connected to anything
+    static inline void spiBegin(uint8_t ssPin = 0) {}
+    static inline void spiInit(uint8_t spiClock) {}
+    static inline void spiSend(uint8_t b) {}
+    static inline void spiSend(const uint8_t* buf, size_t n) {}
+    static inline uint8_t spiReceive() {
+      return 0xff;
+    }
+    static inline void spiReadBlock(uint8_t*buf, uint16_t nbyte) {
+      memset(buf, 0xff, nbyte);
+    }
+    static inline void spiSendBlock(uint8_t token, const uint8_t* buf) {}
+    static inline void i2cInit(unsigned long clockSpeedHz) {}
+    static inline void i2cStartWait(unsigned char address) {}
+    static inline uint8_t i2cStart(unsigned char address) {
+      return 1;
+    }
+    static inline void i2cStartAddr(unsigned char address, unsigned int pos) {}
+    static inline void i2cStop(void) {}
+    static inline void i2cWrite(uint8_t data) {}
+    static inline uint8_t i2cReadAck(void) {
+      return 0;
+    }
+    static inline uint8_t i2cReadNak(void) {
+      return 0;
+    }
+
+    // Watchdog support
+    inline static void startWatchdog() {}
+    inline static void stopWatchdog() {}
+    inline static void pingWatchdog() {}
+
+    inline static float maxExtruderTimerFrequency() {
+      return (float)F_CPU_TRUE / 32;
+    }
+#if FEATURE_SERVO
+    static unsigned int servoTimings[4];
+    static void servoMicroseconds(uint8_t servo, int ms, uint16_t autoOff);
+#endif
+
+    static void analogStart(void);
+#if ADVANCE_EXTRUDER_TIMER
+    static void resetExtruderDirection();
+#endif
+    static volatile uint8_t insideTimer1;
+
+    // ---- simulator ----
+    static uint64_t simulatorTicks; ///< Simulated time since start in F_CPU ticks.
+    static HostPinTracer pinTracer; ///< Called for every pin change, may be NULL.
+    static uint8_t pinState[256];
+    static inline void simulatorWrite(uint8_t pin, uint8_t value)
+    {
+      value = value ? 1 : 0;
+      if(pinState[pin] == value) return;
+      pinState[pin] = value;
+      if(pinTracer != NULL)
+        pinTracer(simulatorTicks, pin, value);
+    }
+    static inline uint8_t simulatorRead(uint8_t pin)
+    {
+      return pinState[pin];
+    }
+    /** Let ticks of simulated time pass and run all interrupts getting due in that time. */
+    static void simulatorAdvance(uint32_t ticks);
+    /** Called from the main loop, see EVENT_PERIODICAL in CustomEvents.h. */
+    static inline void simulatorIdle()
+    {
+      simulatorAdvance(HOST_LOOP_TICKS);
+    }
+
+    // ---- planner profiling, see CustomEvents.h ----
+    /** Simulated time one path planner update takes. It passes when the planner
+    enables interrupts with blocked moves, so the stepper interrupt can starve. */
+    static uint32_t plannerCostTicks;
+    static uint32_t plannerUpdates; ///< Calls of PrintLine::updateTrapezoids
+    static uint64_t plannerHostNanos; ///< Host time spent in updateTrapezoids
+    static uint64_t plannerMaxHostNanos; ///< Slowest updateTrapezoids call
+    static uint32_t stepperStarved; ///< Stepper interrupts that found the next move blocked
+    static uint64_t simulatorHostNanos; ///< Host time spent simulating interrupts
+    static uint64_t hostNanos();
+    static void plannerUpdateStart();
+    static void plannerUpdateEnd();
+    static void plannerPreempt();
+    static void resetStatistics();
+};
+
+#endif // HAL_H
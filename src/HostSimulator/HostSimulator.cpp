@@ -0,0 +1,194 @@
+/*
+    This file is part of Repetier-Firmware.
+
+    Repetier-Firmware is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Repetier-Firmware is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Repetier-Firmware.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+  Replays a G-code file through the firmware and writes every step and
+  direction edge with its simulated timer tick.
+
+  Usage: hostsim [-o trace] [-v] [-u] [-m moves] [-t seconds] file.gcode
+
+  -o  write the step timeline to this file instead of stdout
+  -v  show firmware serial output on stderr
+  -u  send the file to the simulated native USB port
+  -m  move cache size, as if stored in EEPROM before reset
+  -t  abort after this many simulated seconds (default 3600)
+
+  Each trace line is "<tick> <pin name> <level>" where tick counts F_CPU
+  (21 MHz) clocks since reset. A summary is written to stderr at the end.
+  It contains the step jitter of each motor: the mean change between two
+  consecutive step intervals relative to the mean interval. Constant speed
+  gives 0%, a secondary Bresenham axis alternating between 1 and 2 primary
+  steps about 67%. Only intervals below JITTER_MAX_INTERVAL without direction
+  change count, so pauses between moves do not show up. The last lines
+  count the acknowledges ("ok" lines) each port has sent.
+*/
+
+#include "Repetier.h"
+
+#define JITTER_MAX_INTERVAL (F_CPU / 100) // 10ms
+
+struct TracedPin {
+    uint8_t pin;
+    const char *name;
+    uint32_t edges;
+    uint64_t lastRise;      ///< Tick of the last step, 0 = none since direction change
+    uint64_t lastInterval;  ///< Ticks between the last two steps, 0 = none
+    double intervalSum;     ///< Sum of all counted intervals
+    double changeSum;       ///< Sum of the interval changes
+};
+
+// Each step pin is followed by the direction pin of the motor
+static TracedPin tracedPins[] = {
+    {X_STEP_PIN, "X_STEP", 0, 0, 0, 0, 0}, {X_DIR_PIN, "X_DIR", 0, 0, 0, 0, 0},
+    {Y_STEP_PIN, "Y_STEP", 0, 0, 0, 0, 0}, {Y_DIR_PIN, "Y_DIR", 0, 0, 0, 0, 0},
+    {Z_STEP_PIN, "Z_STEP", 0, 0, 0, 0, 0}, {Z_DIR_PIN, "Z_DIR", 0, 0, 0, 0, 0},
+    {E0_STEP_PIN, "E0_STEP", 0, 0, 0, 0, 0}, {E0_DIR_PIN, "E0_DIR", 0, 0, 0, 0, 0}
+};
+static int8_t pinIndex[256];
+static FILE *traceFile = NULL;
+
+static void measureJitter(TracedPin &p, uint64_t tick) {
+    uint64_t interval = p.lastRise ? tick - p.lastRise : 0;
+    if(interval >= JITTER_MAX_INTERVAL) interval = 0;
+    if(interval && p.lastInterval) {
+        p.intervalSum += interval;
+        p.changeSum += interval > p.lastInterval ? interval - p.lastInterval : p.lastInterval - interval;
+    }
+    p.lastRise = tick;
+    p.lastInterval = interval;
+}
+
+static void traceWriter(uint64_t tick, uint8_t pin, uint8_t value) {
+    int8_t idx = pinIndex[pin];
+    if(idx < 0) return;
+    tracedPins[idx].edges++;
+    if(idx & 1) // direction change
+        tracedPins[idx - 1].lastRise = tracedPins[idx - 1].lastInterval = 0;
+    else if(value)
+        measureJitter(tracedPins[idx], tick);
+    fprintf(traceFile, "%llu %s %u\n", (unsigned long long)tick, tracedPins[idx].name, value);
+}
+
+static uint8_t *readFile(const char *name, size_t &length) {
+    FILE *f = fopen(name, "rb");
+    if(f == NULL) return NULL;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t *data = (uint8_t *)malloc(size + 1);
+    length = fread(data, 1, size, f);
+    fclose(f);
+    data[length++] = '\n'; // make sure last line is complete
+    return data;
+}
+
+static void usage() {
+    fprintf(stderr, "usage: hostsim [-o trace] [-v] [-u] [-m moves] [-t seconds] file.gcode\n");
+    exit(2);
+}
+
+int main(int argc, char **argv) {
+    const char *traceName = NULL;
+    const char *gcodeName = NULL;
+    bool verbose = false;
+    bool usb = false;
+    int moveCacheSize = 0;
+    double maxSeconds = 3600;
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "-o") == 0 && i + 1 < argc) traceName = argv[++i];
+        else if(strcmp(argv[i], "-v") == 0) verbose = true;
+#if SERIAL_USB_SOURCE
+        else if(strcmp(argv[i], "-u") == 0) usb = true;
+#endif
+#if DYNAMIC_PRINTLINE_CACHE && EEPROM_MODE != 0
+        else if(strcmp(argv[i], "-m") == 0 && i + 1 < argc) moveCacheSize = atoi(argv[++i]);
+#endif
+        else if(strcmp(argv[i], "-t") == 0 && i + 1 < argc) maxSeconds = atof(argv[++i]);
+        else if(argv[i][0] == '-' || gcodeName != NULL) usage();
+        else gcodeName = argv[i];
+    }
+    if(gcodeName == NULL) usage();
+    size_t length;
+    uint8_t *gcode = readFile(gcodeName, length);
+    if(gcode == NULL) {
+        fprintf(stderr, "could not read %s\n", gcodeName);
+        return 1;
+    }
+    traceFile = stdout;
+    if(traceName != NULL && (traceFile = fopen(traceName, "w")) == NULL) {
+        fprintf(stderr, "could not create %s\n", traceName);
+        return 1;
+    }
+    memset(pinIndex, -1, sizeof(pinIndex));
+    for(uint8_t i = 0; i < ARRAY_SIZE(tracedPins); i++)
+        pinIndex[tracedPins[i].pin] = i;
+    Serial.setOutput(verbose ? stderr : NULL);
+#if SERIAL_USB_SOURCE
+    SerialUSB.setOutput(verbose ? stderr : NULL);
+    HostSerial &port = usb ? SerialUSB : Serial;
+    GCodeSource &source = usb ? static_cast<GCodeSource &>(usbSource) : serial0Source;
+#else
+    HostSerial &port = Serial;
+    GCodeSource &source = serial0Source;
+#endif
+
+    Printer::setup();
+#if DYNAMIC_PRINTLINE_CACHE && EEPROM_MODE != 0
+    if(moveCacheSize) { // same as a reset after changing the size with M206
+        HAL::eprSetInt16(EPR_MOVE_CACHE_SIZE, moveCacheSize);
+        free(PrintLine::lines);
+        PrintLine::allocateCache();
+    }
+#endif
+    port.setInput(gcode, length);
+    HAL::pinTracer = traceWriter;
+    uint64_t maxTicks = static_cast<uint64_t>(maxSeconds * F_CPU);
+    while(HAL::simulatorTicks < maxTicks) {
+        Commands::commandLoop();
+        if(port.inputFinished() && !source.dataAvailable() && GCode::peekCurrentCommand() == NULL && !PrintLine::hasLines()
+#if GCODE_MOVE_RING_SIZE > 0
+                && GCodeMoveRing::isEmpty()
+#endif
+#if INPUT_SHAPING
+                && InputShaper::isIdle()
+#endif
+          )
+            break;
+    }
+    HAL::pinTracer = NULL;
+    if(traceFile != stdout) fclose(traceFile);
+    else fflush(stdout);
+
+    fprintf(stderr, "simulated time: %.6f s\n", (double)HAL::simulatorTicks / F_CPU);
+    for(uint8_t i = 0; i < ARRAY_SIZE(tracedPins); i++) {
+        TracedPin &p = tracedPins[i];
+        if(i & 1 || p.intervalSum == 0)
+            fprintf(stderr, "%-8s %u edges\n", p.name, p.edges);
+        else
+            fprintf(stderr, "%-8s %u edges, jitter %.2f%%\n", p.name, p.edges, 100.0 * p.changeSum / p.intervalSum);
+    }
+    fprintf(stderr, "%-8s %u ok\n", "Serial", Serial.okLines);
+#if SERIAL_USB_SOURCE
+    fprintf(stderr, "%-8s %u ok\n", "SerialUSB", SerialUSB.okLines);
+#endif
+    if(HAL::simulatorTicks >= maxTicks) {
+        fprintf(stderr, "aborted after %.0f simulated seconds\n", maxSeconds);
+        return 1;
+    }
+    free(gcode);
+    return 0;
+}
@@ -0,0 +1,227 @@
+/*
+    This file is part of Repetier-Firmware.
+
+    Repetier-Firmware is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Repetier-Firmware is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Repetier-Firmware.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+  G-code number parser check and benchmark.
+
+  1. Fuzz test: random numbers in G-code format plus odd cases (leading zeros,
+     many digits, exponents, missing digits) are parsed with
+     GCode::parseFloatValue/parseLongValue and with the strtod/strtol based
+     reference. Every float must be bit identical. Mismatches are printed and
+     the exit code is 1.
+  2. Benchmark: host time per number of both parsers for typical slicer
+     values, lines per second of GCode::parseAscii and of the complete input
+     path GCode::readFromSerial for the serial port and, with
+     SERIAL_USB_SOURCE, the native USB source.
+
+  Usage: parserbench [-n count] [-s seed]
+*/
+
+#include "Repetier.h"
+
+static float referenceFloat(char *s) {
+    char *endPtr;
+    while(*s == 32) s++;
+    float f = (strtod(s, &endPtr));
+    if(s == endPtr) f = 0.0;
+    return f;
+}
+
+static long referenceLong(char *s) {
+    char *endPtr;
+    while(*s == 32) s++;
+    long l = (strtol(s, &endPtr, 10));
+    if(s == endPtr) l = 0;
+    return l;
+}
+
+static uint32_t seed = 12345;
+
+static uint32_t rnd(uint32_t range) {
+    seed = seed * 1103515245u + 12345u;
+    return (seed >> 8) % range;
+}
+
+static void randomDigits(char *&p, int count) {
+    while(count-- > 0)
+        *p++ = '0' + rnd(10);
+}
+
+/** Mostly well formed numbers with 0-10 integer and 0-10 fraction digits,
+sometimes with the characters strtod treats differently. */
+static void randomNumber(char *buf) {
+    char *p = buf;
+    uint32_t spaces = rnd(4) == 0 ? rnd(3) : 0;
+    while(spaces--) *p++ = ' ';
+    switch(rnd(8)) {
+    case 0:
+        *p++ = '-';
+        break;
+    case 1:
+        *p++ = '+';
+        break;
+    }
+    if(rnd(6) == 0) {
+        uint32_t zeros = rnd(5);
+        while(zeros--) *p++ = '0';
+    }
+    randomDigits(p, rnd(11));
+    if(rnd(4) != 0) {
+        *p++ = '.';
+        randomDigits(p, rnd(11));
+    }
+    switch(rnd(12)) {
+    case 0:
+        *p++ = 'E';
+        randomDigits(p, 1 + rnd(2));
+        break;
+    case 1:
+        *p++ = 'x';
+        break;
+    case 2:
+        *p++ = ' ';
+        *p++ = 'Y';
+        break;
+    case 3:
+        *p++ = '.';
+        break;
+    }
+    *p = 0;
+}
+
+static uint32_t fuzz(uint32_t count) {
+    char buf[64];
+    uint32_t errors = 0;
+    for(uint32_t i = 0; i < count; i++) {
+        randomNumber(buf);
+        float a = GCode::parseFloatValue(buf), b = referenceFloat(buf);
+        long la = GCode::parseLongValue(buf), lb = referenceLong(buf);
+        if(memcmp(&a, &b, sizeof(float)) != 0 || la != lb) {
+            if(errors++ < 20)
+                printf("mismatch \"%s\": %.9g %ld, reference %.9g %ld\n", buf, a, la, b, lb);
+        }
+    }
+    return errors;
+}
+
+#define BENCH_NUMBERS 4096
+
+static double nanosPerNumber(char numbers[][16], bool reference) {
+    volatile float sink = 0;
+    uint64_t start = HAL::hostNanos();
+    for(int round = 0; round < 200; round++)
+        for(int i = 0; i < BENCH_NUMBERS; i++)
+            sink = sink + (reference ? referenceFloat(numbers[i]) : GCode::parseFloatValue(numbers[i]));
+    return (double)(HAL::hostNanos() - start) / (200.0 * BENCH_NUMBERS);
+}
+
+/** Sends text to a port and counts the commands arriving in GCode::commandsBuffered.
+Commands are removed without executing them, so only the input path is measured. */
+static double linesPerSecond(HostSerial &port, GCodeSource &source, char *text, size_t length) {
+    port.setInput((uint8_t *)text, length);
+    uint32_t count = 0;
+    uint64_t start = HAL::hostNanos();
+    while(!port.inputFinished() || source.dataAvailable() || GCode::peekCurrentCommand() != NULL) {
+        GCode::readFromSerial();
+        GCode *act = GCode::peekCurrentCommand();
+        if(act != NULL) {
+            act->popCurrentCommand();
+            count++;
+        }
+    }
+    return count * 1e9 / (HAL::hostNanos() - start);
+}
+
+static void benchmark() {
+    static char numbers[BENCH_NUMBERS][16];
+    for(int i = 0; i < BENCH_NUMBERS; i++) {
+        switch(i % 3) {
+        case 0: // X/Y with 3 decimals
+            sprintf(numbers[i], "%.3f", rnd(200000) * 0.001);
+            break;
+        case 1: // absolute E with 5 decimals
+            sprintf(numbers[i], "%.5f", rnd(100000000) * 0.00001);
+            break;
+        default: // feedrate
+            sprintf(numbers[i], "%d", 600 + rnd(12000));
+        }
+    }
+    double reference = nanosPerNumber(numbers, true);
+    double fast = nanosPerNumber(numbers, false);
+    printf("%-26s %8.1f ns/number\n", "strtod", reference);
+    printf("%-26s %8.1f ns/number\n", "GCode::parseFloatValue", fast);
+
+    char lines[256][64];
+    for(int i = 0; i < 256; i++) {
+        int length = sprintf(lines[i], "N%d G1 X%.3f Y%.3f E%.5f", 1000 + i, rnd(200000) * 0.001, rnd(200000) * 0.001,
+                             rnd(100000000) * 0.00001);
+        uint8_t checksum = 0;
+        for(int j = 0; j < length; j++)
+            checksum ^= lines[i][j];
+        sprintf(lines[i] + length, "*%d", checksum);
+    }
+    GCode code;
+    char line[64];
+    uint32_t count = 0;
+    uint64_t start = HAL::hostNanos();
+    for(int round = 0; round < 2000; round++)
+        for(int i = 0; i < 256; i++) {
+            strcpy(line, lines[i]);
+            code.parseAscii(line, false);
+            count++;
+        }
+    printf("%-26s %8.0f lines/s\n", "GCode::parseAscii", count * 1e9 / (HAL::hostNanos() - start));
+
+    // complete input path with line numbers and checksums as sent by hosts
+    size_t length = 0;
+    char *text = (char *)malloc(512000 * 64);
+    length += sprintf(text, "M110 N0\n");
+    for(int i = 1; i <= 512000; i++) {
+        int lineLength = sprintf(line, "N%d G1 X%.3f Y%.3f E%.5f", i, rnd(200000) * 0.001, rnd(200000) * 0.001,
+                                 rnd(100000000) * 0.00001);
+        uint8_t checksum = 0;
+        for(int j = 0; j < lineLength; j++)
+            checksum ^= line[j];
+        length += sprintf(text + length, "%s*%d\n", line, checksum);
+    }
+    printf("%-26s %8.0f lines/s\n", "GCode::readFromSerial", linesPerSecond(Serial, serial0Source, text, length));
+#if SERIAL_USB_SOURCE
+    GCodeSource::registerSource(&usbSource);
+    printf("%-26s %8.0f lines/s\n", "USBGCodeSource", linesPerSecond(SerialUSB, usbSource, text, length));
+    GCodeSource::removeSource(&usbSource);
+#endif
+    free(text);
+}
+
+int main(int argc, char **argv) {
+    uint32_t count = 1000000;
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+            count = atol(argv[++i]);
+        else if(strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+            seed = atol(argv[++i]);
+        else {
+            fprintf(stderr, "usage: parserbench [-n count] [-s seed]\n");
+            return 2;
+        }
+    }
+    Serial.setOutput(getenv("BENCH_VERBOSE") ? stderr : NULL);
+    uint32_t errors = fuzz(count);
+    printf("fuzz test: %u numbers, %u mismatches\n", count, errors);
+    benchmark();
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,226 @@
+/*
+    This file is part of Repetier-Firmware.
+
+    Repetier-Firmware is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Repetier-Firmware is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Repetier-Firmware.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+  Path planner benchmark. Runs generated workloads through the complete
+  firmware (gcode parser, queueCartesianMove/queueNonlinearMove and
+  updateTrapezoids) and reports
+
+  - planned segments per second of host time, without simulated interrupts
+  - average and worst updateTrapezoids host time
+  - how often the stepper interrupt found the next move blocked by the planner
+  - simulated print time
+
+  Usage: plannerbench [-p us] [workload ...]
+
+  -p  simulated time one planner update takes (default 200us). The stepper
+      interrupt keeps running during that time, so too few buffered moves
+      show up as starvation.
+
+  Workloads: small-segments, long-travels, spiral, arcs (default all).
+  Build with make DELTA=1 to run them through the delta planner.
+*/
+
+#include "Repetier.h"
+#include <stdarg.h>
+
+#if NONLINEAR_SYSTEM
+#define BENCH_CENTER_X 0.0f
+#define BENCH_CENTER_Y 0.0f
+#else
+#define BENCH_CENTER_X (X_MIN_POS + X_MAX_LENGTH * 0.5f)
+#define BENCH_CENTER_Y (Y_MIN_POS + Y_MAX_LENGTH * 0.5f)
+#endif
+#define BENCH_E_PER_MM 0.033f
+
+struct GCodeText {
+    char *data;
+    size_t length;
+    size_t capacity;
+};
+
+static void addLine(GCodeText &t, const char *format, ...) {
+    if(t.capacity - t.length < 128) {
+        t.capacity = t.capacity * 2 + 4096;
+        t.data = (char *)realloc(t.data, t.capacity);
+    }
+    va_list args;
+    va_start(args, format);
+    t.length += vsnprintf(t.data + t.length, t.capacity - t.length, format, args);
+    va_end(args);
+    t.data[t.length++] = '\n';
+}
+
+static void addStart(GCodeText &t) {
+    addLine(t, "G21");
+    addLine(t, "G90");
+    addLine(t, "M82");
+    addLine(t, "G92 E0");
+    addLine(t, "G1 Z10 F300");
+}
+
+/** Circles of 0.2mm chords like curved perimeters from a slicer. */
+static void smallSegments(GCodeText &t) {
+    float e = 0;
+    const float radius = 30;
+    const int perLap = static_cast<int>(2 * M_PI * radius / 0.2f);
+    addLine(t, "G1 X%.3f Y%.3f F6000", BENCH_CENTER_X + radius, BENCH_CENTER_Y);
+    addLine(t, "G1 F3600");
+    for(int lap = 0; lap < 10; lap++)
+        for(int i = 1; i <= perLap; i++) {
+            float a = 2 * M_PI * i / perLap;
+            e += 0.2f * BENCH_E_PER_MM;
+            addLine(t, "G1 X%.3f Y%.3f E%.5f", BENCH_CENTER_X + radius * cos(a), BENCH_CENTER_Y + radius * sin(a), e);
+        }
+}
+
+/** Fast moves between pseudo random points, no extrusion. */
+static void longTravels(GCodeText &t) {
+    uint32_t seed = 12345;
+    addLine(t, "G1 F12000");
+    for(int i = 0; i < 300; i++) {
+        seed = seed * 1103515245u + 12345u;
+        float x = ((seed >> 8) % 1400) * 0.1f - 70;
+        seed = seed * 1103515245u + 12345u;
+        float y = ((seed >> 8) % 1400) * 0.1f - 70;
+        addLine(t, "G1 X%.3f Y%.3f", BENCH_CENTER_X + x, BENCH_CENTER_Y + y);
+    }
+}
+
+/** Archimedean spiral with slowly rising z, the typical vase mode load. */
+static void spiral(GCodeText &t) {
+    float e = 0, angle = 0, radius = 2;
+    addLine(t, "G1 X%.3f Y%.3f F6000", BENCH_CENTER_X + radius, BENCH_CENTER_Y);
+    addLine(t, "G1 F4800");
+    while(radius < 60) {
+        angle += 0.5f / radius; // 0.5mm segments
+        radius = 2 + angle * 0.4f / (2 * M_PI); // 0.4mm line distance
+        e += 0.5f * BENCH_E_PER_MM;
+        addLine(t, "G1 X%.3f Y%.3f Z%.4f E%.5f", BENCH_CENTER_X + radius * cos(angle), BENCH_CENTER_Y + radius * sin(angle),
+                10 + angle * 0.002f, e);
+    }
+}
+
+/** Alternating G2/G3 half circles of different radius. */
+static void arcs(GCodeText &t) {
+    float e = 0, x = -40;
+    addLine(t, "G1 X%.3f Y%.3f F6000", BENCH_CENTER_X + x, BENCH_CENTER_Y);
+    addLine(t, "G1 F3000");
+    for(int i = 0; i < 200; i++) {
+        float r = 2.5f + (i % 8) * 2.5f;
+        if(x + 2 * r > 40) r = (40 - x) * 0.5f;
+        if(r < 0.5f) {
+            addLine(t, "G1 X%.3f Y%.3f", BENCH_CENTER_X - 40, BENCH_CENTER_Y);
+            x = -40;
+            continue;
+        }
+        x += 2 * r;
+        e += M_PI * r * BENCH_E_PER_MM;
+        addLine(t, "%s X%.3f Y%.3f I%.3f J0 E%.5f", (i & 1) ? "G3" : "G2", BENCH_CENTER_X + x, BENCH_CENTER_Y, r, e);
+    }
+}
+
+struct Workload {
+    const char *name;
+    void (*generate)(GCodeText &t);
+};
+
+static Workload workloads[] = {
+    {"small-segments", smallSegments},
+    {"long-travels", longTravels},
+    {"spiral", spiral},
+    {"arcs", arcs}
+};
+
+static void replay(GCodeText &text) {
+    Serial.setInput(reinterpret_cast<uint8_t *>(text.data), text.length);
+    HAL::resetStatistics();
+    while(!Serial.inputFinished() || GCode::peekCurrentCommand() != NULL || PrintLine::hasLines()
+#if GCODE_MOVE_RING_SIZE > 0
+            || !GCodeMoveRing::isEmpty()
+#endif
+          )
+        Commands::commandLoop();
+}
+
+/** Runs a workload twice. First without moving (M111 no moves debug flag), so
+the planner is never waiting for free queue entries and throughput can be
+measured. Then as real print with the planner cost to count starvation. */
+static void runWorkload(Workload &w, uint32_t plannerCostTicks) {
+    GCodeText text = {NULL, 0, 0};
+    addStart(text);
+    w.generate(text);
+    addLine(text, "M400");
+
+    Printer::debugSet(32);
+    HAL::plannerCostTicks = 0;
+    uint64_t startNanos = HAL::hostNanos();
+    replay(text);
+    uint64_t hostNanos = HAL::hostNanos() - startNanos - HAL::simulatorHostNanos;
+    uint32_t segments = HAL::plannerUpdates;
+    double segmentsPerSecond = hostNanos ? segments * 1e9 / hostNanos : 0;
+    double averageUs = segments ? HAL::plannerHostNanos * 1e-3 / segments : 0;
+    double maxUs = HAL::plannerMaxHostNanos * 1e-3;
+
+    Printer::debugReset(32);
+    HAL::plannerCostTicks = plannerCostTicks;
+    uint64_t startTicks = HAL::simulatorTicks;
+    replay(text);
+    printf("%-16s %9u %12.0f %9.2f %9.2f %8u %10.2f\n", w.name, segments, segmentsPerSecond,
+           averageUs, maxUs, HAL::stepperStarved, (double)(HAL::simulatorTicks - startTicks) / F_CPU);
+    free(text.data);
+}
+
+static void usage() {
+    fprintf(stderr, "usage: plannerbench [-p us] [workload ...]\nworkloads:");
+    for(uint8_t i = 0; i < ARRAY_SIZE(workloads); i++)
+        fprintf(stderr, " %s", workloads[i].name);
+    fprintf(stderr, "\n");
+    exit(2);
+}
+
+int main(int argc, char **argv) {
+    uint32_t plannerCostUs = 200;
+    bool selected[ARRAY_SIZE(workloads)];
+    bool anySelected = false;
+    memset(selected, 0, sizeof(selected));
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+            plannerCostUs = atoi(argv[++i]);
+            continue;
+        }
+        uint8_t w = 0;
+        while(w < ARRAY_SIZE(workloads) && strcmp(argv[i], workloads[w].name) != 0) w++;
+        if(w == ARRAY_SIZE(workloads)) usage();
+        selected[w] = anySelected = true;
+    }
+    Serial.setOutput(getenv("BENCH_VERBOSE") ? stderr : NULL);
+    Printer::setup();
+
+    printf("%s, PRINTLINE_CACHE_SIZE %d, planner cost %u us\n",
+#if NONLINEAR_SYSTEM
+           "delta",
+#else
+           "cartesian",
+#endif
+           (int)PrintLine::getCacheSize(), plannerCostUs);
+    printf("%-16s %9s %12s %9s %9s %8s %10s\n", "workload", "segments", "segments/s", "avg us", "max us", "starved", "print s");
+    for(uint8_t i = 0; i < ARRAY_SIZE(workloads); i++)
+        if(!anySelected || selected[i])
+            runWorkload(workloads[i], plannerCostUs * (F_CPU / 1000000));
+    return 0;
+}
@@ -0,0 +1,36 @@
+/*
+    Pin access for the host simulator. Every pin is a byte in HAL::pinState and
+    writes are forwarded to the trace writer. For STEP_PORT_PARALLEL the pins are
+    also grouped into Due like PIO ports of 32 pins, PIOA has pins 0..31, PIOB
+    32..63 and so on. A PIO_SODR/PIO_CODR write changes all pins of its mask.
+*/
+#ifndef	_FASTIO_H
+#define	_FASTIO_H
+
+#define READ(pin) HAL::simulatorRead(pin)
+#define READ_VAR(pin) HAL::simulatorRead(pin)
+#define WRITE(pin,v) HAL::simulatorWrite(pin,v)
+#define WRITE_VAR(pin,v) HAL::simulatorWrite(pin,v)
+#define	SET_INPUT(pin) {}
+#define	SET_OUTPUT(pin) {}
+#define TOGGLE(pin) WRITE(pin,!READ(pin))
+#define TOGGLE_VAR(pin) HAL::digitalWrite(pin,!HAL::digitalRead(pin))
+
+struct PioOutputRegister {
+    uint8_t firstPin;
+    uint8_t value;
+    void operator=(uint32_t mask); ///< Writes value to all pins with a bit in mask
+};
+struct Pio {
+    PioOutputRegister PIO_SODR;
+    PioOutputRegister PIO_CODR;
+};
+extern Pio hostPio[4];
+#define PIOA (&hostPio[0])
+#define PIOB (&hostPio[1])
+#define PIOC (&hostPio[2])
+#define PIOD (&hostPio[3])
+/** Bit of pin if it is on PIO port, else 0. */
+#define PIN_ON_PORT(pin, port) ((pin) >= 0 && (pin) < 128 && &hostPio[(pin) >> 5] == (port) ? 1UL << ((pin) & 31) : 0)
+
+#endif /* _FASTIO_H */
@@ -0,0 +1,46 @@
+; Backlash compensation with a move cache larger than PRINTLINE_CACHE_SIZE
+; (-m 17 in backlash.args). X changes its direction with every move, so each
+; move gets a compensation move and the write position wraps several times.
+M206 T3 P157 X0.5 ; x backlash 0.5mm
+G92 X0 Y0 Z0 E0
+G1 X10 Y1 F6000
+G1 X5 Y2 F6000
+G1 X10 Y3 F6000
+G1 X5 Y4 F6000
+G1 X10 Y5 F6000
+G1 X5 Y6 F6000
+G1 X10 Y7 F6000
+G1 X5 Y8 F6000
+G1 X10 Y9 F6000
+G1 X5 Y10 F6000
+G1 X10 Y11 F6000
+G1 X5 Y12 F6000
+G1 X10 Y13 F6000
+G1 X5 Y14 F6000
+G1 X10 Y15 F6000
+G1 X5 Y16 F6000
+G1 X10 Y17 F6000
+G1 X5 Y18 F6000
+G1 X10 Y19 F6000
+G1 X5 Y20 F6000
+G1 X10 Y21 F6000
+G1 X5 Y22 F6000
+G1 X10 Y23 F6000
+G1 X5 Y24 F6000
+G1 X10 Y25 F6000
+G1 X5 Y26 F6000
+G1 X10 Y27 F6000
+G1 X5 Y28 F6000
+G1 X10 Y29 F6000
+G1 X5 Y30 F6000
+G1 X10 Y31 F6000
+G1 X5 Y32 F6000
+G1 X10 Y33 F6000
+G1 X5 Y34 F6000
+G1 X10 Y35 F6000
+G1 X5 Y36 F6000
+G1 X10 Y37 F6000
+G1 X5 Y38 F6000
+G1 X10 Y39 F6000
+G1 X5 Y40 F6000
+M400
@@ -0,0 +1,10 @@
+; Moves back toward the min endstops and the z max endstop. The endstops of
+; the simulator never trigger, so every step has to reach the motors:
+; X/Y 50mm out and 40mm back, Z 0.3 + 0.7 + 0.5mm.
+G92 X0 Y0 Z0 E0
+G1 X50 Y50 F3000
+G1 X10 Y10
+G1 Z0.3 F300
+G1 Z1
+G1 Z0.5
+M400
@@ -0,0 +1,12 @@
+; Real-time commands from the native USB port (-u in realtime.args) run ahead
+; of the buffered moves. Like every other command, their ok must go only to
+; the USB port, so Serial stays at 0 ok.
+G92 X0 Y0 Z0 E0
+G1 X20 Y10 F3000
+M105
+G1 X0
+M220 S100
+M221 S100
+G1 Y0
+M105
+M400
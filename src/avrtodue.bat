@@ -24,6 +24,8 @@ copy ArduinoAVR\Repetier\BedLeveling.*  ArduinoDue\Repetier
 copy ArduinoAVR\Repetier\DisplayList.*  ArduinoDue\Repetier
 copy ArduinoAVR\Repetier\Endstops.*  ArduinoDue\Repetier
 copy ArduinoAVR\Repetier\Distortion.*  ArduinoDue\Repetier
+copy ArduinoAVR\Repetier\InputShaper.*  ArduinoDue\Repetier
+copy ArduinoAVR\Repetier\IsrLoad.*  ArduinoDue\Repetier
 
 echo Copying finished. DUE tree is now up to date.
 REM pause